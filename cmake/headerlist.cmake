@@ -1,4 +1,5 @@
 set(headers ${headers}
+	src/AtlasPacker.h
 	src/Cache.h
 	src/Console.h
 	src/ENB/AntTweakBar.h
@@ -8,12 +9,15 @@ set(headers ${headers}
 	src/Graphics.h
 	src/Hooks.h
 	src/ImGui/Backend/imgui_impl_win32.h
+	src/ImGui/FontAtlasCache.h
 	src/ImGui/FormComboBox.h
 	src/ImGui/Graphics.h
 	src/ImGui/IconsFontAwesome6.h
 	src/ImGui/IconsFonts.h
 	src/ImGui/Renderer.h
+	src/ImGui/ScoreItems.h
 	src/ImGui/Styles.h
+	src/ImGui/TrigramIndex.h
 	src/ImGui/Util.h
 	src/ImGui/Widgets.h
 	src/Input.h
@@ -25,10 +29,15 @@ set(headers ${headers}
 	src/PhotoMode/Tabs/CameraPositions.h
 	src/PhotoMode/Tabs/Character.h
 	src/PhotoMode/Tabs/Filters.h
+	src/PhotoMode/Tabs/Gallery.h
 	src/PhotoMode/Tabs/Overlays.h
 	src/PhotoMode/Tabs/Time.h
+	src/PixelBlob.h
+	src/Screenshots/Collection.h
 	src/Screenshots/LoadScreen.h
 	src/Screenshots/Manager.h
+	src/Screenshots/Manifest.h
+	src/Screenshots/Reprocessor.h
 	src/Settings.h
 	src/Translation.h
 )
@@ -1,12 +1,15 @@
 set(sources ${sources}
+	src/AtlasPacker.cpp
 	src/Console.cpp
 	src/Graphics.cpp
 	src/Hooks.cpp
 	src/ImGui/Backend/imgui_impl_win32.cpp
+	src/ImGui/FontAtlasCache.cpp
 	src/ImGui/Graphics.cpp
 	src/ImGui/IconsFonts.cpp
 	src/ImGui/Renderer.cpp
 	src/ImGui/Styles.cpp
+	src/ImGui/TrigramIndex.cpp
 	src/ImGui/Util.cpp
 	src/ImGui/Widgets.cpp
 	src/Input.cpp
@@ -18,10 +21,15 @@ set(sources ${sources}
 	src/PhotoMode/Tabs/CameraPositions.cpp
 	src/PhotoMode/Tabs/Character.cpp
 	src/PhotoMode/Tabs/Filters.cpp
+	src/PhotoMode/Tabs/Gallery.cpp
 	src/PhotoMode/Tabs/Overlays.cpp
 	src/PhotoMode/Tabs/Time.cpp
+	src/PixelBlob.cpp
+	src/Screenshots/Collection.cpp
 	src/Screenshots/LoadScreen.cpp
 	src/Screenshots/Manager.cpp
+	src/Screenshots/Manifest.cpp
+	src/Screenshots/Reprocessor.cpp
 	src/Settings.cpp
 	src/Translation.cpp
 	src/main.cpp
@@ -0,0 +1,136 @@
+#include "AtlasPacker.h"
+
+namespace Texture
+{
+	AtlasPacker::AtlasPacker(std::uint32_t a_pageWidth, std::uint32_t a_pageHeight, std::uint32_t a_padding) :
+		pageWidth(a_pageWidth),
+		pageHeight(a_pageHeight),
+		padding(a_padding)
+	{}
+
+	std::optional<std::vector<AtlasPacker::Rect>> AtlasPacker::Pack(std::span<const Size> a_sizes)
+	{
+		pages.clear();
+
+		// tallest first keeps the skyline flat
+		std::vector<std::size_t> order(a_sizes.size());
+		std::iota(order.begin(), order.end(), 0);
+		std::ranges::stable_sort(order, [&](std::size_t a_lhs, std::size_t a_rhs) {
+			const auto& lhs = a_sizes[a_lhs];
+			const auto& rhs = a_sizes[a_rhs];
+			return lhs.height != rhs.height ? lhs.height > rhs.height : lhs.width > rhs.width;
+		});
+
+		std::vector<Rect> rects(a_sizes.size());
+
+		for (const auto index : order) {
+			const auto& size = a_sizes[index];
+			if (size.width == 0 || size.height == 0) {
+				rects[index] = { 0, 0, 0, 0, 0 };
+				continue;
+			}
+
+			// padding on every side, so filtering never samples a neighbour
+			const auto width = size.width + (padding * 2);
+			const auto height = size.height + (padding * 2);
+			if (width > pageWidth || height > pageHeight) {
+				return std::nullopt;
+			}
+
+			std::size_t   segment = 0;
+			std::uint32_t x = 0;
+			std::uint32_t y = 0;
+
+			auto page = std::ranges::find_if(pages, [&](const Skyline& a_skyline) {
+				return FindPosition(a_skyline, width, height, segment, x, y);
+			});
+			if (page == pages.end()) {
+				pages.push_back({ { 0, 0, pageWidth } });
+				page = std::prev(pages.end());
+				FindPosition(*page, width, height, segment, x, y);
+			}
+
+			Place(*page, segment, x, y, width, height);
+
+			rects[index] = { static_cast<std::uint32_t>(std::distance(pages.begin(), page)), x + padding, y + padding, size.width, size.height };
+		}
+
+		return rects;
+	}
+
+	std::uint32_t AtlasPacker::GetUsedHeight(std::uint32_t a_page) const
+	{
+		if (a_page >= pages.size()) {
+			return 0;
+		}
+		return std::ranges::max(pages[a_page], std::less{}, &Segment::y).y;
+	}
+
+	bool AtlasPacker::FindPosition(const Skyline& a_skyline, std::uint32_t a_width, std::uint32_t a_height, std::size_t& a_outIndex, std::uint32_t& a_outX, std::uint32_t& a_outY) const
+	{
+		bool          found = false;
+		std::uint32_t bestTop = std::numeric_limits<std::uint32_t>::max();
+
+		for (std::size_t i = 0; i < a_skyline.size(); ++i) {
+			const auto x = a_skyline[i].x;
+			if (x + a_width > pageWidth) {
+				break;
+			}
+
+			// resting height is the highest segment under the rect
+			std::uint32_t y = 0;
+			for (std::size_t j = i; j < a_skyline.size() && a_skyline[j].x < x + a_width; ++j) {
+				y = std::max(y, a_skyline[j].y);
+			}
+
+			if (y + a_height > pageHeight) {
+				continue;
+			}
+
+			// bottom-left: lowest top edge wins, leftmost on ties
+			if (const auto top = y + a_height; top < bestTop) {
+				bestTop = top;
+				a_outIndex = i;
+				a_outX = x;
+				a_outY = y;
+				found = true;
+			}
+		}
+
+		return found;
+	}
+
+	void AtlasPacker::Place(Skyline& a_skyline, std::size_t a_index, std::uint32_t a_x, std::uint32_t a_y, std::uint32_t a_width, std::uint32_t a_height) const
+	{
+		a_skyline.insert(a_skyline.begin() + a_index, { a_x, a_y + a_height, a_width });
+
+		// trim the segments now covered by the new one
+		const auto right = a_x + a_width;
+		for (auto i = a_index + 1; i < a_skyline.size();) {
+			auto& segment = a_skyline[i];
+			if (segment.x >= right) {
+				break;
+			}
+
+			const auto overlap = right - segment.x;
+			if (segment.width <= overlap) {
+				a_skyline.erase(a_skyline.begin() + i);
+				continue;
+			}
+
+			segment.x += overlap;
+			segment.width -= overlap;
+			break;
+		}
+
+		// merge neighbours at the same height
+		for (std::size_t i = 0; i + 1 < a_skyline.size();) {
+			if (a_skyline[i].y == a_skyline[i + 1].y) {
+				a_skyline[i].width += a_skyline[i + 1].width;
+				a_skyline.erase(a_skyline.begin() + i + 1);
+			} else {
+				++i;
+			}
+		}
+	}
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+namespace Texture
+{
+	// Skyline bottom-left rectangle packer.
+	// Fills fixed size pages in order and opens a new page once a rect fits on none of them.
+	// Pure geometry, no graphics or game dependencies.
+	class AtlasPacker
+	{
+	public:
+		struct Size
+		{
+			std::uint32_t width;
+			std::uint32_t height;
+		};
+
+		struct Rect
+		{
+			std::uint32_t page;
+			std::uint32_t x;
+			std::uint32_t y;
+			std::uint32_t width;
+			std::uint32_t height;
+		};
+
+		AtlasPacker(std::uint32_t a_pageWidth, std::uint32_t a_pageHeight, std::uint32_t a_padding);
+
+		// Rects are returned in input order, empty sizes get an empty rect on page 0.
+		// nullopt if a rect (with padding) is larger than a page.
+		std::optional<std::vector<Rect>> Pack(std::span<const Size> a_sizes);
+
+		std::uint32_t GetPageCount() const { return static_cast<std::uint32_t>(pages.size()); }
+		std::uint32_t GetUsedHeight(std::uint32_t a_page) const;  // lowest point of the skyline, pages can be cropped to it
+
+	private:
+		// horizontal run of the skyline at height y, runs are sorted by x and cover the page width
+		struct Segment
+		{
+			std::uint32_t x;
+			std::uint32_t y;
+			std::uint32_t width;
+		};
+
+		using Skyline = std::vector<Segment>;
+
+		bool FindPosition(const Skyline& a_skyline, std::uint32_t a_width, std::uint32_t a_height, std::size_t& a_outIndex, std::uint32_t& a_outX, std::uint32_t& a_outY) const;
+		void Place(Skyline& a_skyline, std::size_t a_index, std::uint32_t a_x, std::uint32_t a_y, std::uint32_t a_width, std::uint32_t a_height) const;
+
+		// members
+		std::uint32_t        pageWidth;
+		std::uint32_t        pageHeight;
+		std::uint32_t        padding;
+		std::vector<Skyline> pages{};
+	};
+}
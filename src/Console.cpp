@@ -1,6 +1,7 @@
 #include "Console.h"
 
 #include "PhotoMode/Manager.h"
+#include "Screenshots/Manager.h"
 
 namespace Console
 {
@@ -43,11 +44,48 @@ namespace Console
 		}
 	};
 
+	struct ReprocessPhotos
+	{
+		constexpr static auto OG_COMMAND = "ShowRenderPasses"sv;
+
+		constexpr static auto LONG_NAME = "ReprocessPhotos"sv;
+		constexpr static auto SHORT_NAME = "ReprocessPhotos"sv;
+		constexpr static auto HELP = "Regenerate load screen textures from saved photos, run again to cancel\n"sv;
+
+		static bool Execute(const RE::SCRIPT_PARAMETER*, RE::SCRIPT_FUNCTION::ScriptData*, RE::TESObjectREFR*, RE::TESObjectREFR*, RE::Script*, RE::ScriptLocals*, double&, std::uint32_t&)
+		{
+			const auto screenshots = MANAGER(Screenshot);
+			if (screenshots->IsReprocessing()) {
+				screenshots->PrintReprocessingProgress();
+				screenshots->CancelReprocessing();
+				RE::ConsoleLog::GetSingleton()->Print("Reprocessing cancelled");
+			} else {
+				using Result = Screenshot::Manager::REPROCESS_RESULT;
+				switch (screenshots->StartReprocessing()) {
+				case Result::kStarted:
+					RE::ConsoleLog::GetSingleton()->Print("Reprocessing load screen textures in the background");
+					break;
+				case Result::kNotLoaded:
+					RE::ConsoleLog::GetSingleton()->Print("Photos are not loaded yet");
+					break;
+				case Result::kRunning:
+					RE::ConsoleLog::GetSingleton()->Print("Reprocessing is already running");
+					break;
+				case Result::kNothingToDo:
+					RE::ConsoleLog::GetSingleton()->Print("No photos to reprocess");
+					break;
+				}
+			}
+			return true;
+		}
+	};
+
 	void Install()
 	{
 		logger::info("{:*^30}", "CONSOLE COMMANDS");
 
 		ConsoleCommandHandler<StartPhotoMode>::Install();
 		ConsoleCommandHandler<StopPhotoMode>::Install();
+		ConsoleCommandHandler<ReprocessPhotos>::Install();
 	}
 }
@@ -1,67 +1,306 @@
 #include "Graphics.h"
 
+namespace Path
+{
+	std::string_view Normalize(std::string_view a_path, std::string_view a_root, std::span<char> a_buffer)
+	{
+		// write position never overtakes read position, so a_buffer may alias a_path
+		std::size_t length = 0;
+		bool        lastWasSeparator = true;
+
+		for (const char ch : a_path) {
+			if (ch == '/' || ch == '\\') {
+				if (!lastWasSeparator) {
+					a_buffer[length++] = '\\';
+				}
+				lastWasSeparator = true;
+			} else {
+				a_buffer[length++] = static_cast<char>(std::tolower(static_cast<unsigned char>(ch)));
+				lastWasSeparator = false;
+			}
+		}
+
+		std::string_view result(a_buffer.data(), length);
+
+		for (auto pos = result.find(a_root); pos != std::string_view::npos; pos = result.find(a_root, pos + 1)) {
+			const auto end = pos + a_root.size();
+			if (end < result.size() && result[end] == '\\' && (pos == 0 || !std::isspace(static_cast<unsigned char>(result[pos - 1])))) {
+				result.remove_prefix(end + 1);
+				break;
+			}
+		}
+
+		return result;
+	}
+
+	void NormalizeInPlace(std::string& a_path, std::string_view a_root)
+	{
+		const auto result = Normalize(a_path, a_root, a_path);
+		const auto offset = static_cast<std::size_t>(result.data() - a_path.data());
+
+		a_path.resize(offset + result.size());
+		a_path.erase(0, offset);
+	}
+
+	std::int32_t ExtractIndex(std::string_view a_path, std::string_view a_prefix)
+	{
+		for (auto pos = a_path.find(a_prefix); pos != std::string_view::npos; pos = a_path.find(a_prefix, pos + 1)) {
+			const auto begin = a_path.data() + pos + a_prefix.size();
+			const auto end = a_path.data() + a_path.size();
+			if (begin == end || !std::isdigit(static_cast<unsigned char>(*begin))) {
+				continue;
+			}
+			std::int32_t index = -1;
+			if (std::from_chars(begin, end, index).ec != std::errc()) {
+				return -1;
+			}
+			return index;
+		}
+
+		return -1;
+	}
+}
+
 namespace Texture
 {
 	std::string Sanitize(std::string& a_path)
 	{
-		a_path = clib_util::string::tolower(a_path);
+		Path::NormalizeInPlace(a_path, "textures"sv);
+		return a_path;
+	}
 
-		a_path = srell::regex_replace(a_path, srell::regex("/+|\\\\+"), "\\");
-		a_path = srell::regex_replace(a_path, srell::regex("^\\\\+"), "");
-		a_path = srell::regex_replace(a_path, srell::regex(R"(.*?[^\s]textures\\|^textures\\)", srell::regex::icase), "");
+	void ProcessRowsInParallel(std::size_t a_height, std::size_t a_rowAlignment, const std::function<void(std::size_t, std::size_t)>& a_func)
+	{
+		const std::size_t numThreads = std::max(std::thread::hardware_concurrency(), 1u);
+		const std::size_t rowsPerThread = std::max<std::size_t>((a_height / a_rowAlignment) / numThreads, 1) * a_rowAlignment;
 
-		return a_path;
+		std::vector<std::jthread> threads;
+		threads.reserve(numThreads);
+
+		for (std::size_t i = 0; i < numThreads; ++i) {
+			std::size_t startRow = i * rowsPerThread;
+			if (startRow >= a_height) {
+				break;
+			}
+			// last thread picks up the remainder
+			std::size_t endRow = (i == numThreads - 1) ? a_height : std::min(startRow + rowsPerThread, a_height);
+
+			threads.emplace_back(std::jthread(a_func, startRow, endRow));
+		}
+
+		for (auto& thread : threads) {
+			thread.join();
+		}
 	}
 
-	void AlphaBlendImage(const DirectX::Image* a_baseImg, const DirectX::Image* a_overlayImg, DirectX::ScratchImage& a_outImage, float a_intensity)
+	// box filter, averages a_factor source rows into destination row a_dstRow
+	void DownscaleRows(const DirectX::Image& a_srcImage, const DirectX::Image& a_dstImage, std::size_t a_factor, std::size_t a_dstRow, std::vector<std::uint32_t>& a_sums)
 	{
-		auto hr = a_outImage.InitializeFromImage(*a_baseImg);
-		if (FAILED(hr)) {
-			return;
+		constexpr std::size_t pixelSize = 4;
+
+		const std::size_t rowSize = a_dstImage.width * pixelSize;
+		const std::size_t area = a_factor * a_factor;
+
+		a_sums.assign(rowSize, 0);
+
+		for (std::size_t dy = 0; dy < a_factor; dy++) {
+			const std::uint8_t* srcPixel = a_srcImage.pixels + ((a_dstRow * a_factor + dy) * a_srcImage.rowPitch);
+			for (std::size_t x = 0; x < a_dstImage.width * a_factor; x++) {
+				const std::size_t dstX = (x / a_factor) * pixelSize;
+				for (std::size_t i = 0; i < pixelSize; i++) {
+					a_sums[dstX + i] += srcPixel[x * pixelSize + i];
+				}
+			}
+		}
+
+		std::uint8_t* dstPixel = a_dstImage.pixels + (a_dstRow * a_dstImage.rowPitch);
+		for (std::size_t i = 0; i < rowSize; i++) {
+			dstPixel[i] = static_cast<std::uint8_t>((a_sums[i] + area / 2) / area);
+		}
+	}
+
+	bool InitializeDownscaledImage(const DirectX::Image* a_srcImage, std::size_t a_factor, DirectX::ScratchImage& a_outImage)
+	{
+		if (a_factor < 2 || DirectX::BitsPerPixel(a_srcImage->format) != 32) {
+			return false;
+		}
+
+		const std::size_t width = a_srcImage->width / a_factor;
+		const std::size_t height = a_srcImage->height / a_factor;
+		if (width == 0 || height == 0) {
+			return false;
+		}
+
+		return SUCCEEDED(a_outImage.Initialize2D(a_srcImage->format, width, height, 1, 1));
+	}
+
+	// dHash grid sums, filled from rows as they are produced on any thread
+	class DHashBuilder
+	{
+	public:
+		static constexpr std::size_t gridWidth = 9;
+		static constexpr std::size_t gridHeight = 8;
+
+		DHashBuilder(const DirectX::Image& a_image) :
+			width(a_image.width),
+			height(a_image.height),
+			valid(DirectX::BitsPerPixel(a_image.format) == 32 && a_image.width >= gridWidth && a_image.height >= gridHeight)
+		{
+			if (!valid) {
+				return;
+			}
+			columnCells.resize(width);
+			for (std::size_t x = 0; x < width; x++) {
+				columnCells[x] = static_cast<std::uint8_t>(x * gridWidth / width);
+				columnCounts[columnCells[x]]++;
+			}
 		}
 
-		const auto resultImage = a_outImage.GetImages();
+		bool IsValid() const { return valid; }
+
+		// channel order doesn't matter as long as captures share a format
+		void AddRows(const DirectX::Image& a_image, std::size_t a_startRow, std::size_t a_endRow)
+		{
+			std::array<std::uint64_t, gridWidth * gridHeight> localSums{};
+
+			for (std::size_t y = a_startRow; y < a_endRow; y++) {
+				const std::uint8_t* pixel = a_image.pixels + (y * a_image.rowPitch);
+				const auto          cellRow = localSums.data() + (y * gridHeight / height) * gridWidth;
+
+				for (std::size_t x = 0; x < width; x++, pixel += 4) {
+					cellRow[columnCells[x]] += pixel[0] * 2u + pixel[1] * 5u + pixel[2];
+				}
+			}
+
+			for (std::size_t i = 0; i < localSums.size(); i++) {
+				sums[i] += localSums[i];
+			}
+		}
+
+		std::uint64_t GetHash() const
+		{
+			if (!valid) {
+				return 0;
+			}
+
+			std::uint64_t hash = 0;
+			for (std::size_t y = 0; y < gridHeight; y++) {
+				for (std::size_t x = 0; x < gridWidth - 1; x++) {
+					// cells in a row share a height, so compare averages by cross-multiplying with the other cell's width
+					const auto left = sums[y * gridWidth + x].load() * columnCounts[x + 1];
+					const auto right = sums[y * gridWidth + x + 1].load() * columnCounts[x];
+					if (left < right) {
+						hash |= 1ull << (y * (gridWidth - 1) + x);
+					}
+				}
+			}
+			return hash;
+		}
+
+	private:
+		// members
+		std::size_t                                                    width;
+		std::size_t                                                    height;
+		bool                                                           valid;
+		std::vector<std::uint8_t>                                      columnCells{};
+		std::array<std::uint64_t, gridWidth>                           columnCounts{};
+		std::array<std::atomic<std::uint64_t>, gridWidth * gridHeight> sums{};
+	};
+
+	void ProcessCapture(const DirectX::Image* a_baseImg, const DirectX::Image* a_overlayImg, float a_intensity, DirectX::ScratchImage& a_outImage, DirectX::ScratchImage* a_downscaledImage, std::size_t a_downscaleFactor, std::uint64_t* a_hash)
+	{
+		// without an overlay the capture itself is the photo, rows are only read
+		const DirectX::Image* resultImage = a_baseImg;
+		if (a_overlayImg) {
+			if (FAILED(a_outImage.InitializeFromImage(*a_baseImg))) {
+				return;
+			}
+			resultImage = a_outImage.GetImages();
+		}
 
 		const std::size_t width = a_baseImg->width;
 		const std::size_t height = a_baseImg->height;
 		const std::size_t pixelSize = DirectX::BitsPerPixel(a_baseImg->format) / 8;
 
+		// rows are finished in groups of a_downscaleFactor, then downscaled and hashed right away, while still in cache
+		const DirectX::Image* downscaledImage = nullptr;
+		if (a_downscaledImage && InitializeDownscaledImage(a_baseImg, a_downscaleFactor, *a_downscaledImage)) {
+			downscaledImage = a_downscaledImage->GetImages();
+		}
+		const std::size_t rowGroup = downscaledImage ? a_downscaleFactor : 1;
+
+		std::optional<DHashBuilder> hash;
+		if (a_hash) {
+			hash.emplace(*resultImage);
+		}
+
+		if (!a_overlayImg && !downscaledImage && !(hash && hash->IsValid())) {
+			return;
+		}
+
 		auto processRows = [&](const std::size_t startRow, const std::size_t endRow) {
-			for (std::size_t y = startRow; y < endRow; y++) {
-				std::uint8_t*       resultPixel = resultImage->pixels + (y * resultImage->rowPitch);
-				const std::uint8_t* basePixel = a_baseImg->pixels + (y * a_baseImg->rowPitch);
-				const std::uint8_t* overlayPixel = a_overlayImg->pixels + (y * a_overlayImg->rowPitch);
-
-				for (std::size_t x = 0; x < width; x++) {
-					if (const float overlayAlpha = (overlayPixel[x * pixelSize + 3] / 255.0f) * a_intensity; overlayAlpha > 0.0f) {
-						const float baseAlpha = 1.0f - overlayAlpha;
-
-						for (std::size_t i = 0; i < pixelSize - 1; i++) {
-							float blendedValue = (overlayPixel[x * pixelSize + i] * overlayAlpha) + (basePixel[x * pixelSize + i] * baseAlpha);
-							resultPixel[x * pixelSize + i] = static_cast<std::uint8_t>(std::round(std::min(blendedValue, 255.0f)));
+			std::vector<std::uint32_t> sums;
+
+			for (std::size_t groupStart = startRow; groupStart < endRow; groupStart += rowGroup) {
+				const std::size_t groupEnd = std::min(groupStart + rowGroup, endRow);
+
+				if (a_overlayImg) {
+					for (std::size_t y = groupStart; y < groupEnd; y++) {
+						std::uint8_t*       resultPixel = resultImage->pixels + (y * resultImage->rowPitch);
+						const std::uint8_t* basePixel = a_baseImg->pixels + (y * a_baseImg->rowPitch);
+						const std::uint8_t* overlayPixel = a_overlayImg->pixels + (y * a_overlayImg->rowPitch);
+
+						for (std::size_t x = 0; x < width; x++) {
+							if (const float overlayAlpha = (overlayPixel[x * pixelSize + 3] / 255.0f) * a_intensity; overlayAlpha > 0.0f) {
+								const float baseAlpha = 1.0f - overlayAlpha;
+
+								for (std::size_t i = 0; i < pixelSize - 1; i++) {
+									float blendedValue = (overlayPixel[x * pixelSize + i] * overlayAlpha) + (basePixel[x * pixelSize + i] * baseAlpha);
+									resultPixel[x * pixelSize + i] = static_cast<std::uint8_t>(std::round(std::min(blendedValue, 255.0f)));
+								}
+							}
 						}
 					}
 				}
-			}
-		};
 
-		const auto numThreads = std::thread::hardware_concurrency();
+				if (downscaledImage && groupEnd - groupStart == rowGroup && groupStart / rowGroup < downscaledImage->height) {
+					DownscaleRows(*resultImage, *downscaledImage, rowGroup, groupStart / rowGroup, sums);
+				}
+			}
 
-		std::vector<std::jthread> threads;
-		threads.reserve(numThreads);
+			if (hash && hash->IsValid()) {
+				hash->AddRows(*resultImage, startRow, endRow);
+			}
+		};
 
-		const std::size_t rowsPerThread = height / numThreads;
+		ProcessRowsInParallel(height, rowGroup, processRows);
 
-		for (std::size_t i = 0; i < numThreads; ++i) {
-			std::size_t startRow = i * rowsPerThread;
-			std::size_t endRow = (i + 1) * rowsPerThread;
+		if (hash) {
+			*a_hash = hash->GetHash();
+		}
+	}
 
-			threads.emplace_back(std::jthread(processRows, startRow, endRow));
+	std::uint64_t ComputeDHash(const DirectX::Image* a_image)
+	{
+		if (!a_image) {
+			return 0;
 		}
 
-		for (auto& thread : threads) {
-			thread.join();
+		DHashBuilder hash(*a_image);
+		if (!hash.IsValid()) {
+			return 0;
 		}
+
+		ProcessRowsInParallel(a_image->height, 1, [&](const std::size_t startRow, const std::size_t endRow) {
+			hash.AddRows(*a_image, startRow, endRow);
+		});
+
+		return hash.GetHash();
+	}
+
+	std::uint32_t HammingDistance(std::uint64_t a_lhs, std::uint64_t a_rhs)
+	{
+		return static_cast<std::uint32_t>(std::popcount(a_lhs ^ a_rhs));
 	}
 
 	// https://www.codeproject.com/Articles/471994/OilPaintEffect
@@ -137,71 +376,231 @@ namespace Texture
 			}
 		};
 
-		const auto numThreads = std::thread::hardware_concurrency();
+		ProcessRowsInParallel(height, 1, processRows);
 
-		std::vector<std::jthread> threads;
-		threads.reserve(numThreads);
+		return true;
+	}
 
-		const std::size_t rowsPerThread = height / numThreads;
+	DDSWriter::DDSWriter(std::string_view a_path, const DirectX::TexMetadata& a_metadata) :
+		path(*stl::utf8_to_utf16(a_path))
+	{
+		std::size_t headerSize = 0;
+		if (FAILED(DirectX::EncodeDDSHeader(a_metadata, DirectX::DDS_FLAGS_NONE, nullptr, 0, headerSize))) {
+			failed = true;
+			return;
+		}
 
-		for (std::size_t i = 0; i < numThreads; ++i) {
-			std::size_t startRow = i * rowsPerThread;
-			std::size_t endRow = (i + 1) * rowsPerThread;
+		std::vector<std::uint8_t> header(headerSize);
+		if (FAILED(DirectX::EncodeDDSHeader(a_metadata, DirectX::DDS_FLAGS_NONE, header.data(), header.size(), headerSize))) {
+			failed = true;
+			return;
+		}
 
-			threads.emplace_back(std::jthread(processRows, startRow, endRow));
+		for (std::size_t level = 0; level < a_metadata.mipLevels; level++) {
+			std::size_t rowPitch, slicePitch;
+			if (FAILED(DirectX::ComputePitch(a_metadata.format, std::max<std::size_t>(a_metadata.width >> level, 1), std::max<std::size_t>(a_metadata.height >> level, 1), rowPitch, slicePitch))) {
+				failed = true;
+				return;
+			}
+			expectedSize += slicePitch * a_metadata.arraySize;
 		}
 
-		for (auto& thread : threads) {
-			thread.join();
+		file.open(path, std::ios::binary | std::ios::trunc);
+		if (file.is_open()) {
+			file.write(reinterpret_cast<const char*>(header.data()), static_cast<std::streamsize>(header.size()));
+			failed = !file.good();
 		}
+	}
+
+	DDSWriter::~DDSWriter()
+	{
+		if (!finished) {
+			Finish();
+		}
+	}
+
+	bool DDSWriter::WaitForPendingWrite()
+	{
+		if (pendingWrite.valid() && !pendingWrite.get()) {
+			failed = true;
+		}
+		pendingImage.Release();
+
+		return !failed;
+	}
+
+	bool DDSWriter::WriteImage(const DirectX::Image& a_image)
+	{
+		std::size_t rowPitch, slicePitch;
+		if (FAILED(DirectX::ComputePitch(a_image.format, a_image.width, a_image.height, rowPitch, slicePitch))) {
+			return false;
+		}
+
+		if (a_image.rowPitch == rowPitch) {
+			file.write(reinterpret_cast<const char*>(a_image.pixels), static_cast<std::streamsize>(slicePitch));
+		} else {
+			// padded source rows, DDS rows are tightly packed
+			const std::size_t scanLines = DirectX::ComputeScanlines(a_image.format, a_image.height);
+			for (std::size_t y = 0; y < scanLines && file.good(); y++) {
+				file.write(reinterpret_cast<const char*>(a_image.pixels + (y * a_image.rowPitch)), static_cast<std::streamsize>(rowPitch));
+			}
+		}
+
+		writtenSize += slicePitch;
+
+		return file.good();
+	}
+
+	bool DDSWriter::Append(const DirectX::Image& a_image)
+	{
+		if (!IsValid() || !WaitForPendingWrite()) {
+			return false;
+		}
+
+		pendingWrite = std::async(std::launch::async, [this, a_image]() {
+			return WriteImage(a_image);
+		});
 
 		return true;
 	}
 
-	void CompressTexture(const RE::BSGraphics::Renderer* a_this, const DirectX::ScratchImage& a_inputImage, DirectX::ScratchImage& a_outputImage)
+	bool DDSWriter::Append(DirectX::ScratchImage&& a_image)
 	{
-		// Compress texture
-		const ComPtr<ID3D11Device> device{ reinterpret_cast<ID3D11Device*>(a_this->data.forwarder) };
+		if (!IsValid() || !WaitForPendingWrite()) {
+			return false;
+		}
 
-		auto hr = DirectX::Compress(device.Get(), a_inputImage.GetImages(), 1, a_inputImage.GetMetadata(),
-			DXGI_FORMAT_BC7_UNORM,
-			DirectX::TEX_COMPRESS_BC7_QUICK,
-			0.0f,
-			a_outputImage);
-		if (FAILED(hr)) {
+		// keep the encoded tile alive until it has been written out
+		pendingImage = std::move(a_image);
+		pendingWrite = std::async(std::launch::async, [this]() {
+			for (std::size_t i = 0; i < pendingImage.GetImageCount(); i++) {
+				if (!WriteImage(pendingImage.GetImages()[i])) {
+					return false;
+				}
+			}
+			return true;
+		});
+
+		return true;
+	}
+
+	bool DDSWriter::Finish()
+	{
+		finished = true;
+
+		WaitForPendingWrite();
+
+		if (file.is_open()) {
+			file.close();
+		}
+
+		if (failed || writtenSize != expectedSize) {
+			std::error_code ec;
+			std::filesystem::remove(path, ec);
+			return false;
+		}
+
+		return true;
+	}
+
+	DDSEncoder::DDSEncoder(const RE::BSGraphics::Renderer* a_renderer, const DirectX::Image& a_inputImage, std::string_view a_path, bool a_compress) :
+		inputImage(a_inputImage),
+		device(reinterpret_cast<ID3D11Device*>(a_renderer->data.forwarder)),
+		writer(a_path, GetMetadata(a_inputImage, a_compress)),
+		compress(a_compress)
+	{}
+
+	DirectX::TexMetadata DDSEncoder::GetMetadata(const DirectX::Image& a_inputImage, bool a_compress)
+	{
+		DirectX::TexMetadata metadata{};
+		metadata.width = a_inputImage.width;
+		metadata.height = a_inputImage.height;
+		metadata.depth = 1;
+		metadata.arraySize = 1;
+		metadata.mipLevels = 1;
+		metadata.format = a_compress ? DXGI_FORMAT_BC7_UNORM : a_inputImage.format;
+		metadata.dimension = DirectX::TEX_DIMENSION_TEXTURE2D;
+		return metadata;
+	}
+
+	bool DDSEncoder::Step()
+	{
+		if (IsDone()) {
+			return !failed;
+		}
+
+		if (!compress) {
+			nextRow = inputImage.height;
+			failed = !writer.Append(inputImage);
+			return !failed;
+		}
+
+		DirectX::Image tile = inputImage;
+		tile.height = std::min(TILE_HEIGHT, inputImage.height - nextRow);
+		tile.pixels = inputImage.pixels + (nextRow * inputImage.rowPitch);
+		tile.slicePitch = tile.height * inputImage.rowPitch;
+
+		nextRow += tile.height;
+
+		DirectX::ScratchImage compressedTile;
+		if (FAILED(DirectX::Compress(device.Get(), tile, DXGI_FORMAT_BC7_UNORM, DirectX::TEX_COMPRESS_BC7_QUICK, 0.0f, compressedTile))) {
 			logger::info("Failed to compress dds");
+			failed = true;
+			return false;
 		}
+
+		failed = !writer.Append(std::move(compressedTile));
+		return !failed;
 	}
 
-	void SaveToDDS(const DirectX::ScratchImage& a_inputImage, std::string_view a_path)
+	bool DDSEncoder::Finish()
 	{
-		// Save texture
-		const auto wPath = stl::utf8_to_utf16(a_path);
-		auto       hr = DirectX::SaveToDDSFile(a_inputImage.GetImages(), 1, a_inputImage.GetMetadata(), DirectX::DDS_FLAGS_NONE, wPath->c_str());
-		if (FAILED(hr)) {
+		// the writer removes partial files
+		return writer.Finish() && !failed;
+	}
+
+	bool SaveToDDS(const RE::BSGraphics::Renderer* a_this, const DirectX::Image& a_inputImage, std::string_view a_path, bool a_compress)
+	{
+		DDSEncoder encoder(a_this, a_inputImage, a_path, a_compress);
+		if (!encoder.IsValid()) {
+			logger::info("Failed to save dds");
+			return false;
+		}
+
+		while (!encoder.IsDone() && encoder.Step()) {}
+
+		if (!encoder.Finish()) {
 			logger::info("Failed to save dds");
+			return false;
 		}
+
+		return true;
 	}
 
-	void SaveToPNG(const DirectX::ScratchImage& a_inputImage, std::string_view a_path, bool a_forceSRGB)
+	void SaveToWIC(const DirectX::ScratchImage& a_inputImage, std::string_view a_path, DirectX::WICCodecs a_codec, bool a_forceSRGB)
 	{
 		// Save texture
 		const auto wPath = stl::utf8_to_utf16(a_path);
 		auto       hr = DirectX::SaveToWICFile(*a_inputImage.GetImage(0, 0, 0), a_forceSRGB ? DirectX::WIC_FLAGS_FORCE_SRGB : DirectX::WIC_FLAGS_NONE,
-				  DirectX::GetWICCodec(DirectX::WIC_CODEC_PNG), wPath->c_str());
+				  DirectX::GetWICCodec(a_codec), wPath->c_str());
 		if (FAILED(hr)) {
-			logger::info("Failed to save png");
+			logger::info("Failed to save {}", a_codec == DirectX::WIC_CODEC_PNG ? "png" : "jpg");
 		}
 	}
+
+	void SaveToPNG(const DirectX::ScratchImage& a_inputImage, std::string_view a_path, bool a_forceSRGB)
+	{
+		SaveToWIC(a_inputImage, a_path, DirectX::WIC_CODEC_PNG, a_forceSRGB);
+	}
+
+	void SaveToJPG(const DirectX::ScratchImage& a_inputImage, std::string_view a_path, bool a_forceSRGB)
+	{
+		SaveToWIC(a_inputImage, a_path, DirectX::WIC_CODEC_JPEG, a_forceSRGB);
+	}
 }
 
 std::string Mesh::Sanitize(std::string& a_path)
 {
-	a_path = clib_util::string::tolower(a_path);
-
-	a_path = srell::regex_replace(a_path, srell::regex("/+|\\\\+"), "\\");
-	a_path = srell::regex_replace(a_path, srell::regex("^\\\\+"), "");
-	a_path = srell::regex_replace(a_path, srell::regex(R"(.*?[^\s]meshes\\|^meshes\\)", srell::regex::icase), "");
-
+	Path::NormalizeInPlace(a_path, "meshes"sv);
 	return a_path;
 }
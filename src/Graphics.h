@@ -1,17 +1,96 @@
 #pragma once
 
+namespace Path
+{
+	// Single pass, no allocations: lowercases, collapses runs of '/' and '\\' into a single '\\', drops leading separators
+	// and strips everything up to and including the first "<a_root>\\" (a_root must be lowercase).
+	// a_buffer must hold at least a_path.size() chars and may alias a_path; the result is a view into a_buffer.
+	std::string_view Normalize(std::string_view a_path, std::string_view a_root, std::span<char> a_buffer);
+	void             NormalizeInPlace(std::string& a_path, std::string_view a_root);
+
+	// number following the first occurrence of a_prefix that is followed by a digit, or -1
+	std::int32_t ExtractIndex(std::string_view a_path, std::string_view a_prefix);
+}
+
 namespace Texture
 {
+	// Writes the DDS header up front, then appends pixel data (BC blocks, rows, mips) in file order as it is encoded.
+	// Each append is written on a background thread so encoding of the next tile overlaps the previous write.
+	class DDSWriter
+	{
+	public:
+		DDSWriter(std::string_view a_path, const DirectX::TexMetadata& a_metadata);
+		~DDSWriter();
+
+		DDSWriter(const DDSWriter&) = delete;
+		DDSWriter& operator=(const DDSWriter&) = delete;
+
+		bool IsValid() const { return file.is_open() && !failed; }
+
+		bool Append(const DirectX::Image& a_image);  // a_image must stay alive until the next Append or Finish
+		bool Append(DirectX::ScratchImage&& a_image);
+		bool Finish();
+
+	private:
+		bool WaitForPendingWrite();
+		bool WriteImage(const DirectX::Image& a_image);
+
+		// members
+		std::filesystem::path path{};
+		std::ofstream         file{};
+		std::future<bool>     pendingWrite{};
+		DirectX::ScratchImage pendingImage{};
+		std::size_t           expectedSize{ 0 };
+		std::size_t           writtenSize{ 0 };
+		bool                  failed{ false };
+		bool                  finished{ false };
+	};
+
+	// SaveToDDS split into steps of one BC7 tile, so encoding can be spread across frames.
+	// The input image must outlive the encoder.
+	class DDSEncoder
+	{
+	public:
+		DDSEncoder(const RE::BSGraphics::Renderer* a_renderer, const DirectX::Image& a_inputImage, std::string_view a_path, bool a_compress);
+
+		bool IsValid() const { return writer.IsValid() && !failed; }
+		bool IsDone() const { return failed || nextRow >= inputImage.height; }
+
+		bool Step();
+		bool Finish();
+
+	private:
+		static DirectX::TexMetadata GetMetadata(const DirectX::Image& a_inputImage, bool a_compress);
+
+		// rows encoded per tile, must be a multiple of the 4x4 block size
+		static constexpr std::size_t TILE_HEIGHT{ 256 };
+
+		// members
+		DirectX::Image       inputImage;
+		ComPtr<ID3D11Device> device;
+		DDSWriter            writer;
+		std::size_t          nextRow{ 0 };
+		bool                 compress;
+		bool                 failed{ false };
+	};
+
 	std::string Sanitize(std::string& a_path);
 
-	void AlphaBlendImage(const DirectX::Image* a_baseImg, const DirectX::Image* a_overlayImg, DirectX::ScratchImage& a_outImage, float a_intensity);
+	void ProcessRowsInParallel(std::size_t a_height, std::size_t a_rowAlignment, const std::function<void(std::size_t, std::size_t)>& a_func);
 
-	bool OilPaintingFilter(const DirectX::Image* a_srcImage, std::int32_t a_radius, float a_intensity, DirectX::ScratchImage& a_outImage);
+	// one pass over a capture's rows: blends the overlay into a_outImage (left empty without one),
+	// and optionally downscales and hashes the resulting rows while they're still in cache
+	void ProcessCapture(const DirectX::Image* a_baseImg, const DirectX::Image* a_overlayImg, float a_intensity, DirectX::ScratchImage& a_outImage, DirectX::ScratchImage* a_downscaledImage = nullptr, std::size_t a_downscaleFactor = 1, std::uint64_t* a_hash = nullptr);
 
-	void CompressTexture(const RE::BSGraphics::Renderer* a_this, const DirectX::ScratchImage& a_inputImage, DirectX::ScratchImage& a_outputImage);
+	// 64-bit difference hash over a 9x8 luma grid, 32bpp only (0 if unsupported)
+	std::uint64_t ComputeDHash(const DirectX::Image* a_image);
+	std::uint32_t HammingDistance(std::uint64_t a_lhs, std::uint64_t a_rhs);
+
+	bool OilPaintingFilter(const DirectX::Image* a_srcImage, std::int32_t a_radius, float a_intensity, DirectX::ScratchImage& a_outImage);
 
-	void SaveToDDS(const DirectX::ScratchImage& a_inputImage, std::string_view a_path);
+	bool SaveToDDS(const RE::BSGraphics::Renderer* a_this, const DirectX::Image& a_inputImage, std::string_view a_path, bool a_compress);
 	void SaveToPNG(const DirectX::ScratchImage& a_inputImage, std::string_view a_path, bool a_forceSRGB);
+	void SaveToJPG(const DirectX::ScratchImage& a_inputImage, std::string_view a_path, bool a_forceSRGB);
 }
 
 namespace Mesh
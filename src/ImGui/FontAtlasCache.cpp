@@ -0,0 +1,121 @@
+#include "FontAtlasCache.h"
+
+namespace ImGui
+{
+	const std::uint8_t* FontAtlasCache::GetPixels(ImFontAtlas* a_atlas)
+	{
+		unsigned char* pixels = nullptr;
+		int            texWidth = 0;
+		int            texHeight = 0;
+		a_atlas->GetTexDataAsRGBA32(&pixels, &texWidth, &texHeight);
+		return pixels;
+	}
+
+	bool FontAtlasCache::Capture(ImFontAtlas* a_atlas)
+	{
+		if (!a_atlas->IsBuilt()) {
+			return false;
+		}
+
+		width = a_atlas->TexWidth;
+		height = a_atlas->TexHeight;
+		uvWhitePixel = { a_atlas->TexUvWhitePixel.x, a_atlas->TexUvWhitePixel.y };
+
+		uvLines.clear();
+		for (const auto& line : a_atlas->TexUvLines) {
+			uvLines.push_back({ line.x, line.y, line.z, line.w });
+		}
+
+		fonts.clear();
+		for (const auto font : a_atlas->Fonts) {
+			auto& [fontSize, ascent, descent, glyphs] = fonts.emplace_back();
+			fontSize = font->FontSize;
+			ascent = font->Ascent;
+			descent = font->Descent;
+
+			glyphs.reserve(font->Glyphs.Size);
+			for (const auto& glyph : font->Glyphs) {
+				glyphs.push_back({ glyph.Codepoint, glyph.Colored != 0, glyph.Visible != 0, glyph.AdvanceX,
+					glyph.X0, glyph.Y0, glyph.X1, glyph.Y1,
+					glyph.U0, glyph.V0, glyph.U1, glyph.V1 });
+			}
+		}
+
+		return width > 0 && height > 0 && !fonts.empty();
+	}
+
+	bool FontAtlasCache::Restore(ImFontAtlas* a_atlas, const std::uint8_t* a_pixels) const
+	{
+		if (!a_pixels || width <= 0 || height <= 0 || fonts.empty()) {
+			return false;
+		}
+
+		a_atlas->Clear();
+
+		// placeholder configs without font data, BuildLookupTable reads the ellipsis setting from them
+		for (std::size_t i = 0; i < fonts.size(); ++i) {
+			ImFontConfig config;
+			config.FontDataOwnedByAtlas = false;
+			config.SizePixels = fonts[i].fontSize;
+			ImFormatString(config.Name, IM_ARRAYSIZE(config.Name), "Cached font %d", static_cast<int>(i));
+			a_atlas->ConfigData.push_back(config);
+		}
+
+		for (std::size_t i = 0; i < fonts.size(); ++i) {
+			const auto& [fontSize, ascent, descent, glyphs] = fonts[i];
+
+			auto font = IM_NEW(ImFont);
+			font->ContainerAtlas = a_atlas;
+			font->ConfigData = &a_atlas->ConfigData[static_cast<int>(i)];
+			font->ConfigDataCount = 1;
+			font->FontSize = fontSize;
+			font->Ascent = ascent;
+			font->Descent = descent;
+
+			a_atlas->ConfigData[static_cast<int>(i)].DstFont = font;
+
+			font->Glyphs.reserve(static_cast<int>(glyphs.size()));
+			for (const auto& glyph : glyphs) {
+				ImFontGlyph dst{};
+				dst.Codepoint = glyph.codepoint;
+				dst.Colored = glyph.colored;
+				dst.Visible = glyph.visible;
+				dst.AdvanceX = glyph.advanceX;
+				dst.X0 = glyph.x0;
+				dst.Y0 = glyph.y0;
+				dst.X1 = glyph.x1;
+				dst.Y1 = glyph.y1;
+				dst.U0 = glyph.u0;
+				dst.V0 = glyph.v0;
+				dst.U1 = glyph.u1;
+				dst.V1 = glyph.v1;
+				font->Glyphs.push_back(dst);
+			}
+
+			font->BuildLookupTable();
+			a_atlas->Fonts.push_back(font);
+		}
+
+		// ImGui frees the pixels with the atlas
+		const auto size = static_cast<std::size_t>(width) * height * 4;
+		a_atlas->TexPixelsRGBA32 = static_cast<unsigned int*>(IM_ALLOC(size));
+		std::memcpy(a_atlas->TexPixelsRGBA32, a_pixels, size);
+
+		a_atlas->TexWidth = width;
+		a_atlas->TexHeight = height;
+		a_atlas->TexUvScale = ImVec2(1.0f / width, 1.0f / height);
+		a_atlas->TexUvWhitePixel = ImVec2(uvWhitePixel[0], uvWhitePixel[1]);
+
+		const auto lineCount = std::min(uvLines.size(), std::size(a_atlas->TexUvLines));
+		for (std::size_t i = 0; i < lineCount; ++i) {
+			a_atlas->TexUvLines[i] = ImVec4(uvLines[i][0], uvLines[i][1], uvLines[i][2], uvLines[i][3]);
+		}
+		if (lineCount < std::size(a_atlas->TexUvLines)) {
+			a_atlas->Flags |= ImFontAtlasFlags_NoBakedLines;
+		}
+
+		a_atlas->TexReady = true;
+
+		return true;
+	}
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+namespace ImGui
+{
+	// A built font atlas flattened to glyph tables, so it can be cached on disk and restored without FreeType.
+	// Pixels are stored separately as RGBA32. Only depends on ImGui, so a capture/restore round trip can run headless.
+	struct FontAtlasCache
+	{
+		struct Glyph
+		{
+			std::uint32_t codepoint;
+			bool          colored;
+			bool          visible;
+			float         advanceX;
+			float         x0, y0, x1, y1;
+			float         u0, v0, u1, v1;
+		};
+
+		struct Font
+		{
+			float              fontSize;
+			float              ascent;
+			float              descent;
+			std::vector<Glyph> glyphs;
+		};
+
+		static constexpr std::uint32_t VERSION{ 1 };
+
+		bool Capture(ImFontAtlas* a_atlas);  // after Build, fills everything but the pixels, see GetPixels
+		bool Restore(ImFontAtlas* a_atlas, const std::uint8_t* a_pixels) const;  // a_pixels is width * height RGBA32, copied into the atlas
+
+		static const std::uint8_t* GetPixels(ImFontAtlas* a_atlas);
+
+		// members
+		std::uint32_t                     version{ VERSION };
+		std::uint64_t                     key{ 0 };
+		std::int32_t                      width{ 0 };
+		std::int32_t                      height{ 0 };
+		std::array<float, 2>              uvWhitePixel{};
+		std::vector<std::array<float, 4>> uvLines{};
+		std::vector<Font>                 fonts{};
+	};
+}
+
+template <>
+struct glz::meta<ImGui::FontAtlasCache::Glyph>
+{
+	using T = ImGui::FontAtlasCache::Glyph;
+	static constexpr auto value = array(
+		&T::codepoint, &T::colored, &T::visible, &T::advanceX,
+		&T::x0, &T::y0, &T::x1, &T::y1,
+		&T::u0, &T::v0, &T::u1, &T::v1);
+};
+
+template <>
+struct glz::meta<ImGui::FontAtlasCache::Font>
+{
+	using T = ImGui::FontAtlasCache::Font;
+	static constexpr auto value = object(
+		"fontSize", &T::fontSize,
+		"ascent", &T::ascent,
+		"descent", &T::descent,
+		"glyphs", &T::glyphs);
+};
+
+template <>
+struct glz::meta<ImGui::FontAtlasCache>
+{
+	using T = ImGui::FontAtlasCache;
+	static constexpr auto value = object(
+		"version", &T::version,
+		"key", &T::key,
+		"width", &T::width,
+		"height", &T::height,
+		"uvWhitePixel", &T::uvWhitePixel,
+		"uvLines", &T::uvLines,
+		"fonts", &T::fonts);
+};
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Hooks.h"
+#include "ImGui/TrigramIndex.h"
 #include "ImGui/Widgets.h"
 
 namespace ImGui
@@ -8,70 +9,227 @@ namespace ImGui
 	constexpr auto allMods = "$PM_ALL"sv;
 	constexpr auto ffForms = "$PM_FF_Forms"sv;
 
+	// Every form of one type, gathered once and shared read-only by all combo boxes of that type.
+	// Editor IDs are stored contiguously and grouped by mod, so each mod is a subrange of the full list.
 	template <class T>
-	class FormComboBox
+	class FormCatalog
 	{
 	public:
-		void AddForm(const std::string& a_edid, T* a_form)
+		FormCatalog(const FormCatalog&) = delete;
+		FormCatalog& operator=(const FormCatalog&) = delete;
+
+		// built on first use, after data has loaded
+		static const FormCatalog& GetSingleton()
+		{
+			static const FormCatalog catalog;
+			return catalog;
+		}
+
+		// ALL
+		// ...mods
+		// FF FORMS
+		const std::vector<std::string>& GetModNames() const { return modNames; }
+		std::size_t                     GetModCount() const { return modNames.size(); }
+
+		std::span<const std::string> GetEditorIDs(std::size_t a_mod) const
+		{
+			const auto [begin, end] = modRanges[a_mod];
+			return std::span(edids).subspan(begin, end - begin);
+		}
+		std::span<T* const> GetForms(std::size_t a_mod) const
+		{
+			const auto [begin, end] = modRanges[a_mod];
+			return std::span(forms).subspan(begin, end - begin);
+		}
+
+		// over GetEditorIDs(a_mod), built the first time a mod is browsed
+		const TrigramIndex& GetIndex(std::size_t a_mod) const
 		{
-			if (edidForms.emplace(a_edid, a_form).second) {
-				edids.push_back(a_edid);
+			auto& index = indices[a_mod];
+			if (!index.IsBuilt()) {
+				index.Build(GetEditorIDs(a_mod));
 			}
+			return index;
 		}
-		void UpdateValidForms(RE::Actor* a_actor = nullptr)
+
+	private:
+		FormCatalog()
 		{
-			if (valid) {
-				return;
+			// mod name, forms; the first form with an editor ID wins
+			StringSet                                          seen;
+			StringMap<std::vector<std::pair<std::string, T*>>> modForms;
+			std::vector<std::string>                           modOrder;
+
+			const auto add_form = [&](const std::string& a_edid, T* a_form) {
+				if (!seen.insert(a_edid).second) {
+					return;
+				}
+				std::string modName;
+				if (auto file = a_form->GetFile(0)) {
+					modName = file->fileName;
+				} else {
+					modName = ffForms;
+				}
+				auto [it, inserted] = modForms.try_emplace(modName);
+				if (inserted) {
+					modOrder.push_back(modName);
+				}
+				it->second.emplace_back(a_edid, a_form);
+			};
+
+			if constexpr (!std::is_same_v<T, RE::TESIdleForm>) {
+				for (const auto& form : RE::TESDataHandler::GetSingleton()->GetFormArray<T>()) {
+					if (form) {
+						add_form(editorID::get_editorID(form), form);
+					}
+				}
+			} else {
+				for (auto& [edid, form] : PhotoMode::cachedIdles) {
+					add_form(edid, form);
+				}
 			}
 
-			SetValid(true);
+			const auto add_mod = [&](std::string a_name, std::vector<std::pair<std::string, T*>>& a_forms) {
+				const auto begin = static_cast<std::uint32_t>(edids.size());
+				for (auto& [edid, form] : a_forms) {
+					edids.push_back(std::move(edid));
+					forms.push_back(form);
+				}
+				modNames.push_back(std::move(a_name));
+				modRanges.emplace_back(begin, static_cast<std::uint32_t>(edids.size()));
+				a_forms.clear();
+			};
+
+			modNames.emplace_back(TRANSLATE_S(allMods));
+			modRanges.emplace_back(0, 0);
+
+			// load order, then forms from files that aren't listed, then runtime forms
+			for (const auto& file : RE::TESDataHandler::GetSingleton()->files) {
+				if (const auto it = modForms.find(std::string_view(file->fileName)); it != modForms.end() && !it->second.empty()) {
+					add_mod(it->first, it->second);
+				}
+			}
+			for (const auto& modName : modOrder) {
+				if (auto& remaining = modForms[modName]; !remaining.empty() && modName != ffForms) {
+					add_mod(modName, remaining);
+				}
+			}
+			if (const auto it = modForms.find(ffForms); it != modForms.end() && !it->second.empty()) {
+				add_mod(TRANSLATE_S(ffForms), it->second);
+			}
+
+			modRanges[0] = { 0, static_cast<std::uint32_t>(edids.size()) };
+			indices.resize(modNames.size());
+		}
 
+		// members
+		std::vector<std::string> edids{};
+		std::vector<T*>          forms{};
+
+		std::vector<std::string>                              modNames{};
+		std::vector<std::pair<std::uint32_t, std::uint32_t>> modRanges{};  // [begin, end) in edids
+
+		mutable std::vector<TrigramIndex> indices{};  // render thread only
+	};
+
+	// selection within one mod of a catalog
+	template <class T>
+	class FormComboBox
+	{
+	public:
+		void UpdateValidForms(const FormCatalog<T>& a_catalog, std::size_t a_mod, RE::Actor* a_actor = nullptr)
+		{
 			if constexpr (std::is_same_v<T, RE::TESIdleForm>) {
 				if (!a_actor) {
 					a_actor = RE::PlayerCharacter::GetSingleton();
 				}
-				edids.clear();
-				for (auto& [edid, idle] : edidForms) {
+
+				// results are kept until the actor changes in a way idle conditions usually check
+				if (const auto key = GetActorStateKey(a_actor); key != actorStateKey) {
+					actorStateKey = key;
+					validForms.clear();
+					nextForm = 0;
+				}
+
+				const auto idles = a_catalog.GetForms(a_mod);
+				if (nextForm >= idles.size()) {
+					return;
+				}
+
+				// a slice per frame, the list fills in while the combo is drawn
+				const auto start = std::chrono::steady_clock::now();
+				do {
+					const auto idle = idles[nextForm];
 					if (a_actor->CanUseIdle(idle) && idle->CheckConditions(a_actor, nullptr, false)) {
-						edids.push_back(edid);
+						validForms.push_back(nextForm);
 					}
-				}
+					++nextForm;
+				} while (nextForm < idles.size() && (nextForm % IDLE_BATCH_SIZE != 0 || std::chrono::steady_clock::now() - start < IDLE_FRAME_BUDGET));
 			}
 		}
-		void ResetIndex()
+		void ResetIndex(const FormCatalog<T>& a_catalog, std::size_t a_mod)
 		{
 			index = 0;
 
+			// idle conditions check more than the actor state key covers, so each activation checks again
+			validForms.clear();
+			nextForm = 0;
+
 			if constexpr (std::is_same_v<T, RE::TESWeather>) {
 				if (auto currentWeather = RE::Sky::GetSingleton()->currentWeather) {
-					if (const auto it = edidForms.find(editorID::get_editorID(currentWeather)); it != edidForms.end()) {
-						index = static_cast<std::int32_t>(std::distance(edidForms.begin(), it));
+					const auto weathers = a_catalog.GetForms(a_mod);
+					if (const auto it = std::ranges::find(weathers, currentWeather); it != weathers.end()) {
+						index = static_cast<std::int32_t>(std::distance(weathers.begin(), it));
 					}
 				}
 			}
 		}
-		void SetValid(bool a_valid)
+		T* GetComboWithFilterResult(const FormCatalog<T>& a_catalog, std::size_t a_mod, RE::Actor* a_actor = nullptr)
 		{
-			valid = a_valid;
-		}
+			UpdateValidForms(a_catalog, a_mod, a_actor);
 
-		T* GetComboWithFilterResult(RE::Actor* a_actor = nullptr)
-		{
-			UpdateValidForms(a_actor);
-			if (ImGui::ComboWithFilter("##forms", &index, edids)) {
+			const std::vector<std::uint32_t>* subset = nullptr;
+			if constexpr (std::is_same_v<T, RE::TESIdleForm>) {
+				subset = &validForms;
+			}
+
+			if (ImGui::ComboWithFilter("##forms", &index, a_catalog.GetEditorIDs(a_mod), -1, &a_catalog.GetIndex(a_mod), subset)) {
 				// avoid losing focus
 				ImGui::SetKeyboardFocusHere(-1);
-				return edidForms.find(edids[index])->second;
+				return a_catalog.GetForms(a_mod)[subset ? (*subset)[index] : index];
 			}
 			return nullptr;
 		}
 
 	private:
+		static constexpr std::uint32_t IDLE_BATCH_SIZE{ 16 };  // conditions checked between clock reads
+		static constexpr auto          IDLE_FRAME_BUDGET{ std::chrono::microseconds(1500) };
+
+		static std::uint64_t GetActorStateKey(RE::Actor* a_actor)
+		{
+			const auto actorState = a_actor->AsActorState();
+			const auto actorBase = a_actor->GetActorBase();
+
+			const auto identity = std::format("{:X}|{}|{}|{}|{}|{}|{}|{}|{}|{}",
+				a_actor->GetFormID(),
+				static_cast<const void*>(a_actor->GetRace()),
+				actorBase ? static_cast<std::int32_t>(actorBase->GetSex()) : -1,
+				std::to_underlying(actorState->GetWeaponState()),
+				std::to_underlying(actorState->GetSitSleepState()),
+				actorState->IsSneaking(),
+				a_actor->IsOnMount(),
+				static_cast<const void*>(a_actor->GetEquippedObject(false)),
+				static_cast<const void*>(a_actor->GetEquippedObject(true)),
+				static_cast<const void*>(a_actor->GetParentCell()));
+
+			return ankerl::unordered_dense::hash<std::string_view>{}(identity);
+		}
+
 		// members
-		StringMap<T*>            edidForms{};
-		std::vector<std::string> edids{};
-		std::int32_t             index{};
-		bool                     valid{ false };
+		std::vector<std::uint32_t> validForms{};  // idles the actor can play, positions in the mod
+		std::uint32_t              nextForm{ 0 };  // next idle to check
+		std::uint64_t              actorStateKey{ 0 };
+		std::int32_t               index{};
 	};
 
 	// modName, forms
@@ -83,62 +241,19 @@ namespace ImGui
 			name(std::move(a_name))
 		{}
 
-		void AddForm(const std::string& a_edid, T* a_form)
-		{
-			std::string modName;
-			if (auto file = a_form->GetFile(0)) {
-				modName = file->fileName;
-			} else {
-				modName = ffForms;
-			}
-
-			modNameForms[allMods].AddForm(a_edid, a_form);
-			modNameForms[modName].AddForm(a_edid, a_form);
-		}
 		void InitForms()
 		{
-			if (modNameForms.empty()) {
-				if constexpr (!std::is_same_v<T, RE::TESIdleForm>) {
-					for (const auto& form : RE::TESDataHandler::GetSingleton()->GetFormArray<T>()) {
-						if (form) {
-							AddForm(editorID::get_editorID(form), form);
-						}
-					}
-				} else {
-					for (auto& [edid, form] : PhotoMode::cachedIdles) {
-						AddForm(edid, form);
-					}
-				}
-			}
-
-			// ALL
-			// ...mods
-			// FF FORMS
-
-			if (modNames.empty()) {
-				modNames.reserve(modNameForms.size());
-				modNames.emplace_back(TRANSLATE_S(allMods));
-
-				for (const auto& file : RE::TESDataHandler::GetSingleton()->files) {
-					if (modNameForms.contains(file->fileName)) {
-						modNames.emplace_back(file->fileName);
-					}
-				}
-				if (modNameForms.contains(ffForms)) {
-					containsFF = true;
-					modNames.emplace_back(TRANSLATE_S(ffForms));
-				}
+			if (!catalog) {
+				catalog = &FormCatalog<T>::GetSingleton();
 			}
 
 			Reset();
 		}
 		void Reset()
 		{
-			curMod = allMods;
 			index = 0;
-			for (auto& [modName, formData] : modNameForms) {
-				formData.ResetIndex();
-				formData.SetValid(false);
+			for (auto& [mod, formData] : modForms) {
+				formData.ResetIndex(*catalog, mod);
 			}
 		}
 
@@ -161,20 +276,18 @@ namespace ImGui
 				ImGui::PushID(name.c_str());
 				ImGui::PushMultiItemsWidths(2, ImGui::GetContentRegionAvail().x);
 
-				if (ImGui::ComboWithFilter("##mods", &index, modNames)) {
-					if (index == 0) {
-						curMod = allMods;
-					} else if (containsFF && index == modNames.size() - 1) {
-						curMod = ffForms;
-					} else {
-						curMod = modNames[index];
-					}
-				}
+				ImGui::ComboWithFilter("##mods", &index, catalog->GetModNames());
 
 				ImGui::PopItemWidth();
 				ImGui::SameLine(0, ImGui::GetStyle().ItemInnerSpacing.x);
 
-				formResult = modNameForms[curMod].GetComboWithFilterResult(a_actor);
+				// per mod selection is only created once a mod is browsed
+				const auto curMod = static_cast<std::size_t>(index);
+				auto [it, inserted] = modForms.try_emplace(curMod);
+				if (inserted) {
+					it->second.ResetIndex(*catalog, curMod);
+				}
+				formResult = it->second.GetComboWithFilterResult(*catalog, curMod, a_actor);
 
 				ImGui::PopItemWidth();
 				ImGui::PopID();
@@ -192,11 +305,8 @@ namespace ImGui
 		std::string name;
 		bool        translated{ false };
 
-		StringMap<FormComboBox<T>> modNameForms{};
-		std::vector<std::string>   modNames{};
-		std::int32_t               index{};
-		bool                       containsFF{ false };
-
-		std::string curMod{ allMods };
+		const FormCatalog<T>*             catalog{ nullptr };  // shared by every combo box of this type
+		Map<std::size_t, FormComboBox<T>> modForms{};
+		std::int32_t                      index{};  // mod
 	};
 }
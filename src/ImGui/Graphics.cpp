@@ -19,49 +19,107 @@ namespace ImGui
 		if (image) {
 			image.reset();
 		}
+		if (blob) {
+			blob.reset();
+		}
 	}
 
 	bool Texture::Load(bool a_resizeToScreenRes)
 	{
-		bool result = false;
+		return Decode(a_resizeToScreenRes) && Upload();
+	}
 
+	bool Texture::Decode(bool a_resizeToScreenRes)
+	{
 		image = std::make_shared<DirectX::ScratchImage>();
 		HRESULT hr = DirectX::LoadFromWICFile(path.c_str(), DirectX::WIC_FLAGS_IGNORE_SRGB, nullptr, *image);
 
-		if (SUCCEEDED(hr)) {
-			if (auto renderer = RE::BSGraphics::Renderer::GetSingleton()) {
-				if (a_resizeToScreenRes) {
-					static auto screenSize = RE::BSGraphics::Renderer::GetScreenSize();
-					if (screenSize.height != image->GetMetadata().height && screenSize.width != image->GetMetadata().width) {
-						DirectX::ScratchImage tmpImage;
-						DirectX::Resize(*image->GetImage(0, 0, 0), screenSize.width, screenSize.height, DirectX::TEX_FILTER_CUBIC, tmpImage);
-
-						image.reset();  // is this needed
-						image = std::make_shared<DirectX::ScratchImage>(std::move(tmpImage));
-					}
-				}
-
-				ComPtr<ID3D11Resource> pTexture{};
-				hr = DirectX::CreateTexture((ID3D11Device*)renderer->data.forwarder, image->GetImages(), 1, image->GetMetadata(), &pTexture);
-
-				if (SUCCEEDED(hr)) {
-					D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc{};
-					srvDesc.Format = image->GetMetadata().format;
-					srvDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
-					srvDesc.Texture2D.MipLevels = 1;
-					srvDesc.Texture2D.MostDetailedMip = 0;
-
-					hr = ((ID3D11Device*)renderer->data.forwarder)->CreateShaderResourceView(pTexture.Get(), &srvDesc, &srView);
-					result = SUCCEEDED(hr);
-				}
-
-				size.x = static_cast<float>(image->GetMetadata().width);
-				size.y = static_cast<float>(image->GetMetadata().height);
-
-				pTexture.Reset();
+		if (FAILED(hr)) {
+			image.reset();
+			return false;
+		}
+
+		if (a_resizeToScreenRes) {
+			static auto screenSize = RE::BSGraphics::Renderer::GetScreenSize();
+			if (screenSize.height != image->GetMetadata().height && screenSize.width != image->GetMetadata().width) {
+				DirectX::ScratchImage tmpImage;
+				DirectX::Resize(*image->GetImage(0, 0, 0), screenSize.width, screenSize.height, DirectX::TEX_FILTER_CUBIC, tmpImage);
+
+				image = std::make_shared<DirectX::ScratchImage>(std::move(tmpImage));
 			}
 		}
 
-		return result;
+		size.x = static_cast<float>(image->GetMetadata().width);
+		size.y = static_cast<float>(image->GetMetadata().height);
+
+		return true;
+	}
+
+	void Texture::SetPixels(std::shared_ptr<::Texture::PixelBlob> a_blob)
+	{
+		blob = std::move(a_blob);
+		image.reset();
+
+		size.x = static_cast<float>(blob->GetImage().width);
+		size.y = static_cast<float>(blob->GetImage().height);
+	}
+
+	void Texture::ReleasePixels()
+	{
+		image.reset();
+		blob.reset();
+	}
+
+	const DirectX::Image* Texture::GetImage() const
+	{
+		if (image) {
+			return image->GetImage(0, 0, 0);
+		}
+		if (blob) {
+			return &blob->GetImage();
+		}
+		return nullptr;
+	}
+
+	bool Texture::Upload()
+	{
+		const auto renderer = RE::BSGraphics::Renderer::GetSingleton();
+		const auto pixels = GetImage();
+		if (!renderer || !pixels) {
+			return false;
+		}
+
+		const auto device = reinterpret_cast<ID3D11Device*>(renderer->data.forwarder);
+
+		// straight from the decoded or mapped rows
+		D3D11_TEXTURE2D_DESC texDesc{};
+		texDesc.Width = static_cast<UINT>(pixels->width);
+		texDesc.Height = static_cast<UINT>(pixels->height);
+		texDesc.MipLevels = 1;
+		texDesc.ArraySize = 1;
+		texDesc.Format = pixels->format;
+		texDesc.SampleDesc.Count = 1;
+		texDesc.Usage = D3D11_USAGE_IMMUTABLE;
+		texDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+
+		D3D11_SUBRESOURCE_DATA initData{};
+		initData.pSysMem = pixels->pixels;
+		initData.SysMemPitch = static_cast<UINT>(pixels->rowPitch);
+
+		ComPtr<ID3D11Texture2D> pTexture{};
+		HRESULT                 hr = device->CreateTexture2D(&texDesc, &initData, &pTexture);
+
+		if (FAILED(hr)) {
+			return false;
+		}
+
+		D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc{};
+		srvDesc.Format = pixels->format;
+		srvDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
+		srvDesc.Texture2D.MipLevels = 1;
+		srvDesc.Texture2D.MostDetailedMip = 0;
+
+		hr = device->CreateShaderResourceView(pTexture.Get(), &srvDesc, &srView);
+		return SUCCEEDED(hr);
 	}
 }
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "PixelBlob.h"
+
 namespace ImGui
 {
 	struct Texture
@@ -12,10 +14,19 @@ namespace ImGui
 
 		virtual bool Load(bool a_resizeToScreenRes);
 
+		// Load split in two, so decoding can happen off the render thread
+		bool Decode(bool a_resizeToScreenRes);
+		void SetPixels(std::shared_ptr<::Texture::PixelBlob> a_blob);  // instead of Decode
+		bool Upload();
+		void ReleasePixels();  // keeps the GPU texture only
+
+		const DirectX::Image* GetImage() const;  // decoded or mapped pixels, nullptr if neither
+
 		// members
 		std::wstring                           path{};
 		ComPtr<ID3D11ShaderResourceView>       srView{ nullptr };
 		std::shared_ptr<DirectX::ScratchImage> image{ nullptr };
+		std::shared_ptr<::Texture::PixelBlob>  blob{ nullptr };
 		ImVec2                                 size{};
 	};
 }
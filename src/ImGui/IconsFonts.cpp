@@ -1,10 +1,12 @@
 #include "IconsFonts.h"
 
+#include "FontAtlasCache.h"
 #include "IconsFontAwesome6.h"
 #include "Input.h"
 #include "Renderer.h"
 #include "Settings.h"
 #include "Styles.h"
+#include "Translation.h"
 #include "Util.h"
 
 namespace IconFont
@@ -58,53 +60,478 @@ namespace IconFont
 		buttonScheme = static_cast<BUTTON_SCHEME>(a_ini.GetLongValue("Controls", "iButtonScheme", std::to_underlying(buttonScheme)));
 	}
 
+	std::filesystem::path Manager::GetAtlasDirectory()
+	{
+		static std::filesystem::path path{};
+		if (path.empty()) {
+			if (auto directory = logger::log_directory()) {
+				directory->remove_filename();
+				*directory /= "Saves\\PhotoMode\\Icons"sv;
+				path = *directory;
+			}
+		}
+		return path;
+	}
+
+	void Manager::RemoveCacheFiles(const std::filesystem::path& a_directory, const StringSet& a_keep)
+	{
+		std::error_code ec;
+		for (const auto& entry : std::filesystem::directory_iterator(a_directory, ec)) {
+			if (entry.is_regular_file(ec) && !a_keep.contains(entry.path().filename().string())) {
+				std::filesystem::remove(entry.path(), ec);
+			}
+		}
+	}
+
+	std::filesystem::path Manager::GetFontCacheDirectory()
+	{
+		static std::filesystem::path path{};
+		if (path.empty()) {
+			if (auto directory = logger::log_directory()) {
+				directory->remove_filename();
+				*directory /= "Saves\\PhotoMode\\Fonts"sv;
+				path = *directory;
+			}
+		}
+		return path;
+	}
+
+	std::vector<IconTexture*> Manager::GetAllIcons()
+	{
+		std::vector<IconTexture*> icons{ &unknownKey, &upKey, &downKey, &leftKey, &rightKey };
+
+		for (auto& icon : keyboard | std::views::values) {
+			icons.push_back(&icon);
+		}
+		for (auto& [xbox, ps4] : gamePad | std::views::values) {
+			icons.push_back(&xbox);
+			icons.push_back(&ps4);
+		}
+		for (auto& icon : mouse | std::views::values) {
+			icons.push_back(&icon);
+		}
+
+		icons.insert(icons.end(), { &stepperLeft, &stepperRight, &checkbox, &checkboxFilled });
+
+		return icons;
+	}
+
+	std::uint64_t Manager::GetIconSetKey(const std::vector<IconTexture*>& a_icons) const
+	{
+		// any icon replaced by a mod changes the key
+		std::string identity = std::format("{}|{}|{}", AtlasTable::VERSION, ATLAS_SIZE, ATLAS_PADDING);
+		for (const auto icon : a_icons) {
+			std::error_code ec;
+			const auto      size = std::filesystem::file_size(icon->path, ec);
+			const auto      mtime = std::filesystem::last_write_time(icon->path, ec).time_since_epoch().count();
+			identity += std::format("|{}|{}|{}", stl::utf16_to_utf8(icon->path).value_or(""s), size, mtime);
+		}
+		return ankerl::unordered_dense::hash<std::string_view>{}(identity);
+	}
+
+	bool Manager::LoadIconAtlas(const std::vector<IconTexture*>& a_icons, std::uint64_t a_key)
+	{
+		const auto directory = GetAtlasDirectory();
+
+		AtlasTable  table;
+		std::string buffer;
+		if (auto glz_ec = glz::read_file_beve(table, (directory / std::format("{:016X}.beve", a_key)).string(), buffer); glz_ec ||
+			table.version != AtlasTable::VERSION || table.key != a_key || table.rects.size() != a_icons.size()) {
+			return false;
+		}
+
+		std::vector<ComPtr<ID3D11ShaderResourceView>> views;
+		for (std::uint32_t page = 0; page < table.pageHeights.size(); ++page) {
+			const Texture::PixelBlob::Key blobKey{ a_key + page, ATLAS_SIZE, table.pageHeights[page], DXGI_FORMAT_R8G8B8A8_UNORM };
+
+			auto blob = Texture::PixelBlob::Open(directory / blobKey.GetFileName(), blobKey);
+			if (!blob) {
+				return false;
+			}
+
+			ImGui::Texture texture(L""sv);
+			texture.SetPixels(std::move(blob));
+			if (!texture.Upload()) {
+				return false;
+			}
+			views.push_back(texture.srView);
+		}
+
+		atlasViews = std::move(views);
+		ApplyIconAtlas(a_icons, table);
+
+		return true;
+	}
+
+	bool Manager::BuildIconAtlas(const std::vector<IconTexture*>& a_icons, std::uint64_t a_key)
+	{
+		std::vector<DirectX::ScratchImage>      images(a_icons.size());
+		std::vector<Texture::AtlasPacker::Size> sizes(a_icons.size(), { 0, 0 });
+
+		for (std::size_t i = 0; i < a_icons.size(); ++i) {
+			// missing icons stay empty, same as a failed Load
+			DirectX::ScratchImage image;
+			if (FAILED(DirectX::LoadFromWICFile(a_icons[i]->path.c_str(), DirectX::WIC_FLAGS_IGNORE_SRGB, nullptr, image))) {
+				logger::info("Failed to load icon {}", stl::utf16_to_utf8(a_icons[i]->path).value_or(""s));
+				continue;
+			}
+
+			if (image.GetMetadata().format != DXGI_FORMAT_R8G8B8A8_UNORM) {
+				if (FAILED(DirectX::Convert(*image.GetImage(0, 0, 0), DXGI_FORMAT_R8G8B8A8_UNORM, DirectX::TEX_FILTER_DEFAULT, DirectX::TEX_THRESHOLD_DEFAULT, images[i]))) {
+					continue;
+				}
+			} else {
+				images[i] = std::move(image);
+			}
+
+			sizes[i] = { static_cast<std::uint32_t>(images[i].GetMetadata().width), static_cast<std::uint32_t>(images[i].GetMetadata().height) };
+		}
+
+		Texture::AtlasPacker packer(ATLAS_SIZE, ATLAS_SIZE, ATLAS_PADDING);
+
+		auto rects = packer.Pack(sizes);
+		if (!rects) {
+			logger::info("Icons don't fit a {0}x{0} atlas page", ATLAS_SIZE);
+			return false;
+		}
+
+		AtlasTable table{};
+		table.key = a_key;
+		table.rects = std::move(*rects);
+
+		const auto directory = GetAtlasDirectory();
+
+		// one icon set is in use at a time, files of earlier sets are removed once this one is written
+		StringSet files{ std::format("{:016X}.beve", a_key) };
+
+		std::vector<ComPtr<ID3D11ShaderResourceView>> views;
+		for (std::uint32_t page = 0; page < packer.GetPageCount(); ++page) {
+			// pages are cropped to the packed height
+			const auto height = packer.GetUsedHeight(page);
+
+			auto pageImage = std::make_shared<DirectX::ScratchImage>();
+			if (FAILED(pageImage->Initialize2D(DXGI_FORMAT_R8G8B8A8_UNORM, ATLAS_SIZE, height, 1, 1))) {
+				return false;
+			}
+
+			const auto pixels = pageImage->GetImage(0, 0, 0);
+			std::memset(pixels->pixels, 0, pixels->slicePitch);
+
+			for (std::size_t i = 0; i < a_icons.size(); ++i) {
+				const auto& rect = table.rects[i];
+				if (rect.page != page || rect.width == 0) {
+					continue;
+				}
+				const auto src = images[i].GetImage(0, 0, 0);
+				for (std::uint32_t row = 0; row < rect.height; ++row) {
+					std::memcpy(pixels->pixels + ((rect.y + row) * pixels->rowPitch) + (rect.x * 4), src->pixels + (row * src->rowPitch), rect.width * 4);
+				}
+			}
+
+			const Texture::PixelBlob::Key blobKey{ a_key + page, ATLAS_SIZE, height, DXGI_FORMAT_R8G8B8A8_UNORM };
+			if (!Texture::PixelBlob::Write(directory / blobKey.GetFileName(), blobKey, *pixels)) {
+				logger::info("Failed to cache icon atlas page {}", page);
+			}
+			files.insert(blobKey.GetFileName());
+
+			ImGui::Texture texture(L""sv);
+			texture.image = std::move(pageImage);
+			if (!texture.Upload()) {
+				return false;
+			}
+			views.push_back(texture.srView);
+
+			table.pageHeights.push_back(height);
+		}
+
+		// table last, a partial cache never matches
+		std::string buffer;
+		if (auto glz_ec = glz::write_file_beve(table, (directory / std::format("{:016X}.beve", a_key)).string(), buffer)) {
+			logger::info("Failed to cache icon atlas ({})", glz::format_error(glz_ec, buffer));
+		} else {
+			RemoveCacheFiles(directory, files);
+		}
+
+		atlasViews = std::move(views);
+		ApplyIconAtlas(a_icons, table);
+
+		logger::info("Packed {} icons into {} atlas pages", a_icons.size(), atlasViews.size());
+
+		return true;
+	}
+
+	void Manager::ApplyIconAtlas(const std::vector<IconTexture*>& a_icons, const AtlasTable& a_table)
+	{
+		for (std::size_t i = 0; i < a_icons.size(); ++i) {
+			const auto& rect = a_table.rects[i];
+			if (rect.width == 0) {
+				continue;
+			}
+
+			const auto icon = a_icons[i];
+			const auto pageWidth = static_cast<float>(ATLAS_SIZE);
+			const auto pageHeight = static_cast<float>(a_table.pageHeights[rect.page]);
+
+			icon->srView = atlasViews[rect.page];
+			icon->uv0 = ImVec2(rect.x / pageWidth, rect.y / pageHeight);
+			icon->uv1 = ImVec2((rect.x + rect.width) / pageWidth, (rect.y + rect.height) / pageHeight);
+			icon->imageSize = icon->size = ImVec2(static_cast<float>(rect.width), static_cast<float>(rect.height));
+		}
+	}
+
 	void Manager::LoadIcons()
 	{
-		unknownKey.Load();
+		const auto icons = GetAllIcons();
+		const auto key = GetIconSetKey(icons);
 
-		upKey.Load();
-		downKey.Load();
-		leftKey.Load();
-		rightKey.Load();
+		if (LoadIconAtlas(icons, key) || BuildIconAtlas(icons, key)) {
+			return;
+		}
 
-		std::for_each(keyboard.begin(), keyboard.end(), [](auto& IconTexture) {
-			IconTexture.second.Load();
-		});
-		std::for_each(gamePad.begin(), gamePad.end(), [](auto& IconTexture) {
-			auto& [xbox, ps4] = IconTexture.second;
-			xbox.Load();
-			ps4.Load();
-		});
-		std::for_each(mouse.begin(), mouse.end(), [](auto& IconTexture) {
-			IconTexture.second.Load();
-		});
+		// one texture per icon
+		for (const auto icon : icons) {
+			icon->Load();
+		}
+	}
+
+	std::uint64_t Manager::GetFontAtlasKey(const ImVector<ImWchar>& a_ranges) const
+	{
+		// sizes are already scaled by resolution
+		std::string identity = std::format("{}|{}|{}|{}|{}|{}|{}", ImGui::FontAtlasCache::VERSION, IMGUI_VERSION_NUM, fontSize, iconSize, largeFontSize, largeIconSize, a_ranges.Size);
+		for (const auto path : { std::string_view(fontName), std::string_view(R"(Data\Interface\ImGuiIcons\Fonts\)" FONT_ICON_FILE_NAME_FAS) }) {
+			std::error_code ec;
+			const auto      size = std::filesystem::file_size(path, ec);
+			const auto      mtime = std::filesystem::last_write_time(path, ec).time_since_epoch().count();
+			identity += std::format("|{}|{}|{}", path, size, mtime);
+		}
+		identity.append(reinterpret_cast<const char*>(a_ranges.Data), a_ranges.size_in_bytes());
 
-		stepperLeft.Load();
-		stepperRight.Load();
-		checkbox.Load();
-		checkboxFilled.Load();
+		return ankerl::unordered_dense::hash<std::string_view>{}(identity);
 	}
 
-	void Manager::ReloadFonts()
+	bool Manager::LoadFontAtlas(std::uint64_t a_key)
 	{
+		const auto directory = GetFontCacheDirectory();
+
+		ImGui::FontAtlasCache cache;
+		std::string           buffer;
+		if (auto glz_ec = glz::read_file_beve(cache, (directory / std::format("{:016X}.beve", a_key)).string(), buffer); glz_ec ||
+			cache.version != ImGui::FontAtlasCache::VERSION || cache.key != a_key || cache.fonts.size() != 2) {
+			return false;
+		}
+
+		const Texture::PixelBlob::Key blobKey{ a_key, static_cast<std::uint32_t>(cache.width), static_cast<std::uint32_t>(cache.height), DXGI_FORMAT_R8G8B8A8_UNORM };
+
+		const auto blob = Texture::PixelBlob::Open(directory / blobKey.GetFileName(), blobKey);
+		if (!blob || blob->GetImage().width != blobKey.width || blob->GetImage().height != blobKey.height) {
+			return false;
+		}
+
 		auto& io = ImGui::GetIO();
-		io.Fonts->Clear();
+		if (!cache.Restore(io.Fonts, blob->GetImage().pixels)) {
+			io.Fonts->Clear();
+			return false;
+		}
+
+		// the table's write time is the atlas' last use, for pruning
+		std::error_code ec;
+		std::filesystem::last_write_time(directory / std::format("{:016X}.beve", a_key), std::filesystem::file_time_type::clock::now(), ec);
+
+		return true;
+	}
+
+	void Manager::SaveFontAtlas(std::uint64_t a_key) const
+	{
+		const auto& io = ImGui::GetIO();
+
+		ImGui::FontAtlasCache cache;
+		if (!cache.Capture(io.Fonts)) {
+			return;
+		}
+		cache.key = a_key;
+
+		const auto pixels = ImGui::FontAtlasCache::GetPixels(io.Fonts);
+		if (!pixels) {
+			return;
+		}
+
+		const Texture::PixelBlob::Key blobKey{ a_key, static_cast<std::uint32_t>(cache.width), static_cast<std::uint32_t>(cache.height), DXGI_FORMAT_R8G8B8A8_UNORM };
+
+		DirectX::Image image{};
+		image.width = cache.width;
+		image.height = cache.height;
+		image.format = DXGI_FORMAT_R8G8B8A8_UNORM;
+		image.rowPitch = static_cast<std::size_t>(cache.width) * 4;
+		image.slicePitch = image.rowPitch * cache.height;
+		image.pixels = const_cast<std::uint8_t*>(pixels);
+
+		const auto directory = GetFontCacheDirectory();
+
+		// pixels first, the table is what marks the entry as complete
+		if (!Texture::PixelBlob::Write(directory / blobKey.GetFileName(), blobKey, image)) {
+			logger::info("Failed to cache font atlas pixels");
+			return;
+		}
+
+		std::string buffer;
+		if (auto glz_ec = glz::write_file_beve(cache, (directory / std::format("{:016X}.beve", a_key)).string(), buffer)) {
+			logger::info("Failed to cache font atlas ({})", glz::format_error(glz_ec, buffer));
+			return;
+		}
+
+		PruneFontAtlases();
+	}
+
+	void Manager::PruneFontAtlases()
+	{
+		const auto directory = GetFontCacheDirectory();
+
+		// tables by last use, newest first
+		std::vector<std::pair<std::filesystem::file_time_type, std::string>> tables;
+		std::vector<std::string>                                             blobs;
+
+		std::error_code ec;
+		for (const auto& entry : std::filesystem::directory_iterator(directory, ec)) {
+			if (!entry.is_regular_file(ec)) {
+				continue;
+			}
+			if (entry.path().extension() == ".beve") {
+				tables.emplace_back(entry.last_write_time(ec), entry.path().stem().string());
+			} else {
+				blobs.push_back(entry.path().filename().string());
+			}
+		}
+
+		if (tables.size() <= MAX_FONT_ATLASES) {
+			return;
+		}
+
+		std::ranges::sort(tables, std::greater{});
+		tables.resize(MAX_FONT_ATLASES);
+
+		// {key}.beve and {key}_{width}x{height}_{format}.bin
+		StringSet keys;
+		StringSet keep;
+		for (auto& [time, key] : tables) {
+			keep.insert(key + ".beve");
+			keys.insert(std::move(key));
+		}
+		for (auto& blob : blobs) {
+			if (keys.contains(std::string_view(blob).substr(0, blob.find('_')))) {
+				keep.insert(std::move(blob));
+			}
+		}
+
+		RemoveCacheFiles(directory, keep);
+	}
+
+	void Manager::AddGlyphs(std::string_view a_text)
+	{
+		// most strings are ASCII, already in the base ranges
+		if (std::ranges::all_of(a_text, [](char c) { return static_cast<unsigned char>(c) < 0x80; })) {
+			return;
+		}
+
+		std::scoped_lock guard(glyphLock);
+
+		const char* text = a_text.data();
+		const char* textEnd = text + a_text.size();
+		while (text < textEnd) {
+			unsigned int c = 0;
+			text += ImTextCharFromUtf8(&c, text, textEnd);
+			if (c > 0xFF && c <= IM_UNICODE_CODEPOINT_MAX && glyphs.emplace(static_cast<ImWchar>(c)).second) {
+				newGlyphs = true;
+			}
+		}
+	}
+
+	void Manager::UpdateGlyphs()
+	{
+		if (!newGlyphs || !ImGui::GetIO().Fonts->IsBuilt()) {
+			return;
+		}
+
+		// each rebuild is a full atlas rebuild, so typing into a filter or scrolling a list waits for the popup to close
+		if (ImGui::IsPopupOpen("", ImGuiPopupFlags_AnyPopupId | ImGuiPopupFlags_AnyPopupLevel)) {
+			return;
+		}
+
+		const auto now = std::chrono::steady_clock::now();
+		if (now - lastGlyphRebuild < GLYPH_REBUILD_INTERVAL) {
+			return;
+		}
+		lastGlyphRebuild = now;
+
+		ReloadFonts(false);
+	}
+
+	void Manager::SaveFontCache()
+	{
+		if (unsavedFontAtlas) {
+			SaveFontAtlas(*unsavedFontAtlas);
+			unsavedFontAtlas.reset();
+		}
+	}
+
+	ImVector<ImWchar> Manager::GetGlyphRanges()
+	{
+		if (!loadedTranslationGlyphs) {
+			for (const auto& translation : MANAGER(Translation)->GetTranslations() | std::views::values) {
+				AddGlyphs(translation);
+			}
+			loadedTranslationGlyphs = true;
+		}
 
 		ImVector<ImWchar> ranges;
 
 		ImFontGlyphRangesBuilder builder;
+		builder.AddRanges(ImGui::GetIO().Fonts->GetGlyphRangesDefault());  // Basic Latin, Latin-1
 		builder.AddText(RE::BSScaleformManager::GetSingleton()->validNameChars.c_str());
 		builder.AddChar(0xf030);  // CAMERA
 		builder.AddChar(0xf017);  // CLOCK
 		builder.AddChar(0xf183);  // PERSON
 		builder.AddChar(0xf042);  // CONTRAST
 		builder.AddChar(0xf03e);  // IMAGE
+		builder.AddChar(0xf302);  // IMAGES
+		{
+			std::scoped_lock guard(glyphLock);
+			for (const auto c : glyphs) {
+				builder.AddChar(c);
+			}
+			newGlyphs = false;
+		}
 		builder.BuildRanges(&ranges);
 
-		io.FontDefault = LoadFontIconSet(fontSize, iconSize, ranges);
-		largeFont = LoadFontIconSet(largeFontSize, largeIconSize, ranges);
+		return ranges;
+	}
 
-		io.Fonts->Build();
+	void Manager::ReloadFonts(bool a_saveCache)
+	{
+		auto& io = ImGui::GetIO();
+		io.Fonts->Clear();
+
+		// every valid name character of the game language, plus glyphs seen in other strings
+		const auto ranges = GetGlyphRanges();
+		const auto key = GetFontAtlasKey(ranges);
+
+		if (LoadFontAtlas(key)) {
+			io.FontDefault = io.Fonts->Fonts[0];
+			largeFont = io.Fonts->Fonts[1];
+			unsavedFontAtlas.reset();
+		} else {
+			io.FontDefault = LoadFontIconSet(fontSize, iconSize, ranges);
+			largeFont = LoadFontIconSet(largeFontSize, largeIconSize, ranges);
+
+			io.Fonts->Build();
+
+			// atlases grown in session are written once, the last one before the menu closes
+			if (a_saveCache) {
+				SaveFontAtlas(key);
+				unsavedFontAtlas.reset();
+			} else {
+				unsavedFontAtlas = key;
+			}
+		}
 
 		ImGui_ImplDX11_InvalidateDeviceObjects();
 		ImGui_ImplDX11_CreateDeviceObjects();
@@ -256,7 +683,7 @@ ImVec2 ImGui::ButtonIcon(const IconFont::IconTexture* a_texture, bool a_centerIc
 		const float height = ImGui::GetWindowSize().y;
 		ImGui::SetCursorPosY((height - a_texture->size.y) / 2);
 	}
-	ImGui::Image((ImTextureID)a_texture->srView.Get(), a_texture->size);
+	ImGui::Image((ImTextureID)a_texture->srView.Get(), a_texture->size, a_texture->uv0, a_texture->uv1);
 
 	return a_texture->size;
 }
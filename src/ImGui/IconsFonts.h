@@ -1,5 +1,6 @@
 #pragma once
 
+#include "AtlasPacker.h"
 #include "ImGui/Graphics.h"
 
 namespace IconFont
@@ -16,6 +17,20 @@ namespace IconFont
 
 		// members
 		ImVec2 imageSize{};
+		ImVec2 uv0{ 0.0f, 0.0f };  // sub-rect in the icon atlas
+		ImVec2 uv1{ 1.0f, 1.0f };
+	};
+
+	// icon atlas layout, saved next to the page pixels
+	struct AtlasTable
+	{
+		static constexpr std::uint32_t VERSION{ 1 };
+
+		// members
+		std::uint32_t                           version{ VERSION };
+		std::uint64_t                           key{ 0 };
+		std::vector<std::uint32_t>              pageHeights{};
+		std::vector<Texture::AtlasPacker::Rect> rects{};  // LoadIcons order
 	};
 
 	class Manager final : public REX::Singleton<Manager>
@@ -31,9 +46,14 @@ namespace IconFont
 		void LoadMCMSettings(const CSimpleIniA& a_ini);
 
 		void LoadIcons();
-		void ReloadFonts();
+		void ReloadFonts(bool a_saveCache = true);
 		void ResizeIcons();
 
+		// glyphs outside the game language's name characters are only baked once a string using them is seen
+		void AddGlyphs(std::string_view a_text);
+		void UpdateGlyphs();   // render thread, before NewFrame; batched while a popup is open
+		void SaveFontCache();  // atlases grown since the last save, when photo mode closes
+
 		ImFont* GetLargeFont() const;
 
 		const IconTexture* GetStepperLeft() const;
@@ -54,6 +74,32 @@ namespace IconFont
 			kPS4
 		};
 
+		// all icons share one or two atlas pages, cached on disk by icon set
+		static constexpr std::uint32_t ATLAS_SIZE{ 2048 };
+		static constexpr std::uint32_t ATLAS_PADDING{ 2 };
+
+		static std::filesystem::path GetAtlasDirectory();
+		static void                  RemoveCacheFiles(const std::filesystem::path& a_directory, const StringSet& a_keep);  // every file but a_keep
+
+		std::vector<IconTexture*> GetAllIcons();
+		std::uint64_t             GetIconSetKey(const std::vector<IconTexture*>& a_icons) const;
+		bool                      LoadIconAtlas(const std::vector<IconTexture*>& a_icons, std::uint64_t a_key);
+		bool                      BuildIconAtlas(const std::vector<IconTexture*>& a_icons, std::uint64_t a_key);
+		void                      ApplyIconAtlas(const std::vector<IconTexture*>& a_icons, const AtlasTable& a_table);
+
+		// the built font atlas is cached on disk by font files, sizes and glyph ranges
+		// glyphs seen in game grow the ranges, so only the most recently used atlases are kept
+		static constexpr std::size_t MAX_FONT_ATLASES{ 8 };
+
+		static std::filesystem::path GetFontCacheDirectory();
+		static void                  PruneFontAtlases();
+
+		ImVector<ImWchar> GetGlyphRanges();
+
+		std::uint64_t GetFontAtlasKey(const ImVector<ImWchar>& a_ranges) const;
+		bool          LoadFontAtlas(std::uint64_t a_key);
+		void          SaveFontAtlas(std::uint64_t a_key) const;
+
 		void    LoadFontSettings(CSimpleIniA& a_ini);
 		ImFont* LoadFontIconSet(float a_fontSize, float a_iconSize, const ImVector<ImWchar>& a_ranges) const;
 
@@ -68,6 +114,17 @@ namespace IconFont
 
 		ImFont* largeFont{ nullptr };
 
+		static constexpr auto GLYPH_REBUILD_INTERVAL{ std::chrono::seconds(1) };  // outside popups
+
+		std::mutex                            glyphLock{};
+		Set<ImWchar>                          glyphs{};  // beyond Latin-1
+		std::atomic_bool                      newGlyphs{ false };
+		bool                                  loadedTranslationGlyphs{ false };
+		std::chrono::steady_clock::time_point lastGlyphRebuild{};
+		std::optional<std::uint64_t>          unsavedFontAtlas{};  // grown in session, not on disk yet
+
+		std::vector<ComPtr<ID3D11ShaderResourceView>> atlasViews{};
+
 		IconTexture stepperLeft{ L"StepperLeft"sv };
 		IconTexture stepperRight{ L"StepperRight"sv };
 		IconTexture checkbox{ L"Checkbox"sv };
@@ -212,6 +269,29 @@ namespace IconFont
 	};
 }
 
+template <>
+struct glz::meta<Texture::AtlasPacker::Rect>
+{
+	using T = Texture::AtlasPacker::Rect;
+	static constexpr auto value = object(
+		"page", &T::page,
+		"x", &T::x,
+		"y", &T::y,
+		"width", &T::width,
+		"height", &T::height);
+};
+
+template <>
+struct glz::meta<IconFont::AtlasTable>
+{
+	using T = IconFont::AtlasTable;
+	static constexpr auto value = object(
+		"version", &T::version,
+		"key", &T::key,
+		"pageHeights", &T::pageHeights,
+		"rects", &T::rects);
+};
+
 namespace ImGui
 {
 	ImVec2 ButtonIcon(std::uint32_t a_key);
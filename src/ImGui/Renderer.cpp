@@ -3,6 +3,7 @@
 #include "Styles.h"
 
 #include "PhotoMode/Manager.h"
+#include "Screenshots/Manager.h"
 
 namespace ImGui::Renderer
 {
@@ -100,6 +101,12 @@ namespace ImGui::Renderer
 				return func(a_menu);
 			}
 
+			// screenshot index is assigned here once the collections have loaded
+			MANAGER(Screenshot)->OnLoadScreenshots();
+
+			// background texture reprocessing, a few GPU compressed tiles per frame
+			MANAGER(Screenshot)->UpdateReprocessing();
+
 			const auto photoMode = MANAGER(PhotoMode);
 
 			if (!photoMode->IsActive() || !photoMode->OnFrameUpdate()) {
@@ -109,6 +116,9 @@ namespace ImGui::Renderer
 			// refresh style
 			ImGui::Styles::GetSingleton()->OnStyleRefresh();
 
+			// bake glyphs first seen last frame
+			MANAGER(IconFont)->UpdateGlyphs();
+
 			ImGui_ImplDX11_NewFrame();
 			SKSE::ImGui_ImplWin32_NewFrame();
 			{
@@ -0,0 +1,82 @@
+#pragma once
+
+namespace ImGui
+{
+	// Fuzzy scoring behind the filtered combo boxes. No ImGui or game dependencies.
+
+	using ItemScore = std::pair<int, double>;
+
+	// better score first, ties keep list order
+	inline bool RanksBefore(const ItemScore& a, const ItemScore& b)
+	{
+		return a.second != b.second ? b.second < a.second : a.first < b.first;
+	}
+
+	struct ScoreResult
+	{
+		std::vector<int>       matches;  // every item above the cutoff, in list order
+		std::vector<ItemScore> scores;   // the same matches, the first `ranked` in rank order
+		std::size_t            ranked{ 0 };
+	};
+
+	// extends the ranked prefix of a_scores to at least a_count entries, the rest stays unordered
+	inline void RankScores(std::vector<ItemScore>& a_scores, std::size_t& a_ranked, std::size_t a_count)
+	{
+		const auto end = std::min(a_count, a_scores.size());
+		if (end > a_ranked) {
+			std::partial_sort(a_scores.begin() + a_ranked, a_scores.begin() + end, a_scores.end(), RanksBefore);
+			a_ranked = end;
+		}
+	}
+
+	// scores a_candidates (all a_itemCount items if null) in chunks across threads once there are enough of them
+	// every match is kept, but only the first a_rankCount are sorted; the list ranks more as it is scrolled
+	template <class F>
+	ScoreResult ScoreItems(std::string_view a_pattern, F&& a_getItem, std::size_t a_itemCount, const std::vector<int>* a_candidates, double a_minScore, std::size_t a_rankCount)
+	{
+		constexpr std::size_t minChunkSize = 2048;
+
+		const std::size_t count = a_candidates ? a_candidates->size() : a_itemCount;
+		const std::size_t numChunks = std::clamp<std::size_t>(count / minChunkSize, 1, std::max(std::thread::hardware_concurrency(), 1u));
+		const std::size_t chunkSize = (count + numChunks - 1) / numChunks;
+
+		std::vector<std::vector<ItemScore>> chunks(numChunks);
+
+		const auto score_chunk = [&](std::size_t a_chunk) {
+			// one scorer per thread, built once per pattern
+			rapidfuzz::fuzz::CachedPartialTokenRatio<char> scorer(a_pattern);
+
+			auto& scores = chunks[a_chunk];
+
+			const std::size_t end = std::min(count, (a_chunk + 1) * chunkSize);
+			for (std::size_t i = a_chunk * chunkSize; i < end; ++i) {
+				const int  index = a_candidates ? (*a_candidates)[i] : static_cast<int>(i);
+				const auto score = scorer.similarity(a_getItem(index), a_minScore);
+				if (score >= a_minScore) {
+					scores.emplace_back(index, score);
+				}
+			}
+		};
+
+		{
+			std::vector<std::jthread> threads;
+			threads.reserve(numChunks - 1);
+			for (std::size_t i = 1; i < numChunks; ++i) {
+				threads.emplace_back(score_chunk, i);
+			}
+			score_chunk(0);
+		}
+
+		ScoreResult result;
+		for (auto& scores : chunks) {
+			for (const auto& [index, score] : scores) {
+				result.matches.push_back(index);
+			}
+			result.scores.insert(result.scores.end(), scores.begin(), scores.end());
+		}
+
+		RankScores(result.scores, result.ranked, a_rankCount);
+
+		return result;
+	}
+}
@@ -117,14 +117,14 @@ namespace ImGui
 		ConvertVec4StylesToU32();
 	}
 
-	void Styles::OnStyleRefresh()
+	std::uint64_t Styles::GetFingerprint(FileType a_type)
 	{
-		if (!refreshStyle) {
-			return;
-		}
-
-		LoadStyles();
+		const auto identity = std::format("{}|{}", Settings::GetSingleton()->GetFingerprint(a_type), Renderer::GetResolutionScale());
+		return ankerl::unordered_dense::hash<std::string_view>{}(identity);
+	}
 
+	void Styles::ApplyStyle() const
+	{
 		ImGuiStyle style;
 		auto&      colors = style.Colors;
 
@@ -169,15 +169,33 @@ namespace ImGui
 
 		style.ScaleAllSizes(Renderer::GetResolutionScale());
 		ImGui::GetStyle() = style;
+	}
+
+	void Styles::OnStyleRefresh()
+	{
+		if (!refreshStyle) {
+			return;
+		}
+
+		refreshStyle = false;
 
-		// reload fonts/icons
+		// colours, sizes and icon scales
+		if (const auto styles = GetFingerprint(FileType::kStyles); styles != appliedStyles) {
+			LoadStyles();
+			ApplyStyle();
 
-		MANAGER(IconFont)->LoadSettings();
+			MANAGER(IconFont)->ResizeIcons();
 
-		MANAGER(IconFont)->ReloadFonts();
-		MANAGER(IconFont)->ResizeIcons();
+			appliedStyles = styles;
+		}
 
-		refreshStyle = false;
+		// font atlas, also recreates device objects
+		if (const auto fonts = GetFingerprint(FileType::kFonts); fonts != appliedFonts) {
+			MANAGER(IconFont)->LoadSettings();
+			MANAGER(IconFont)->ReloadFonts();
+
+			appliedFonts = fonts;
+		}
 	}
 
 	void Styles::RefreshStyle()
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "Settings.h"
+
 namespace ImGui
 {
 	enum class USER_STYLE
@@ -33,6 +35,9 @@ namespace ImGui
 
 	private:
 		void ConvertVec4StylesToU32();
+		void ApplyStyle() const;
+
+		static std::uint64_t GetFingerprint(FileType a_type);  // file contents and resolution scale
 
 		template <class T>
 		std::pair<T, bool> ToStyle(const std::string& a_str);
@@ -98,6 +103,10 @@ namespace ImGui
 		ImU32 iconDisabledU32;
 
 		bool refreshStyle{ false };
+
+		// inputs of the last applied refresh, a stage only reruns when its own inputs changed
+		std::optional<std::uint64_t> appliedStyles{};
+		std::optional<std::uint64_t> appliedFonts{};
 	};
 
 	ImU32  GetUserStyleColorU32(USER_STYLE a_style);
@@ -0,0 +1,91 @@
+#include "TrigramIndex.h"
+
+namespace ImGui
+{
+	template <class F>
+	void TrigramIndex::ForEachTrigram(std::string_view a_text, F&& a_func)
+	{
+		const auto is_token_char = [](char c) {
+			return std::isalnum(static_cast<unsigned char>(c)) || static_cast<unsigned char>(c) >= 0x80;
+		};
+		const auto fold = [](char c) {
+			return static_cast<std::uint32_t>(static_cast<unsigned char>(std::tolower(static_cast<unsigned char>(c))));
+		};
+
+		std::size_t tokenStart = 0;
+		for (std::size_t i = 0; i <= a_text.size(); ++i) {
+			if (i < a_text.size() && is_token_char(a_text[i])) {
+				continue;
+			}
+			for (std::size_t j = tokenStart; j + 3 <= i; ++j) {
+				a_func((fold(a_text[j]) << 16) | (fold(a_text[j + 1]) << 8) | fold(a_text[j + 2]));
+			}
+			tokenStart = i + 1;
+		}
+	}
+
+	void TrigramIndex::Build(std::span<const std::string> a_items)
+	{
+		Clear();
+
+		for (int i = 0; i < static_cast<int>(a_items.size()); ++i) {
+			ForEachTrigram(a_items[i], [&](std::uint32_t a_trigram) {
+				auto& items = postings[a_trigram];
+				if (items.empty() || items.back() != i) {
+					items.push_back(i);
+				}
+			});
+		}
+
+		itemCount = a_items.size();
+		built = true;
+	}
+
+	void TrigramIndex::Clear()
+	{
+		postings.clear();
+		itemCount = 0;
+		built = false;
+	}
+
+	std::optional<std::vector<int>> TrigramIndex::Query(std::string_view a_pattern, const std::vector<std::uint32_t>* a_subset) const
+	{
+		Set<std::uint32_t> trigrams;
+		ForEachTrigram(a_pattern, [&](std::uint32_t a_trigram) {
+			trigrams.insert(a_trigram);
+		});
+
+		if (trigrams.empty()) {
+			return std::nullopt;
+		}
+
+		// loose enough for typos and partial words, each edit breaks up to three trigrams
+		const auto minShared = std::max<std::size_t>(trigrams.size() / 3, 1);
+
+		std::vector<std::uint16_t> shared(itemCount, 0);
+		for (const auto trigram : trigrams) {
+			if (const auto it = postings.find(trigram); it != postings.end()) {
+				for (const auto item : it->second) {
+					shared[item]++;
+				}
+			}
+		}
+
+		std::vector<int> candidates;
+		if (a_subset) {
+			for (int i = 0; i < static_cast<int>(a_subset->size()); ++i) {
+				if (const auto item = (*a_subset)[i]; item < itemCount && shared[item] >= minShared) {
+					candidates.push_back(i);
+				}
+			}
+		} else {
+			for (int i = 0; i < static_cast<int>(itemCount); ++i) {
+				if (shared[i] >= minShared) {
+					candidates.push_back(i);
+				}
+			}
+		}
+
+		return candidates;
+	}
+}
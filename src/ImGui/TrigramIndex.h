@@ -0,0 +1,29 @@
+#pragma once
+
+namespace ImGui
+{
+	// Inverted index from case-folded trigrams to the items containing them, to narrow fuzzy search candidates.
+	// Trigrams never span tokens, so reordered words still share them. No ImGui or game dependencies.
+	class TrigramIndex
+	{
+	public:
+		void Build(std::span<const std::string> a_items);
+		void Clear();
+
+		bool IsBuilt() const { return built; }
+
+		// items sharing at least a third of the pattern's trigrams, in list order; nullopt if the pattern has none
+		// a prefilter, fuzzy matches without a whole trigram in common are dropped
+		// with a_subset, only those items are considered and positions in a_subset are returned
+		std::optional<std::vector<int>> Query(std::string_view a_pattern, const std::vector<std::uint32_t>* a_subset = nullptr) const;
+
+	private:
+		template <class F>
+		static void ForEachTrigram(std::string_view a_text, F&& a_func);
+
+		// members
+		Map<std::uint32_t, std::vector<int>> postings{};  // item indices, ascending
+		std::size_t                          itemCount{ 0 };
+		bool                                 built{ false };
+	};
+}
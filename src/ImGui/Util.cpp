@@ -1,5 +1,6 @@
 #include "Util.h"
 
+#include "IconsFonts.h"
 #include "Input.h"
 
 namespace ImGui
@@ -75,6 +76,8 @@ namespace ImGui
 
 	void CenteredText(const char* label, bool vertical)
 	{
+		MANAGER(IconFont)->AddGlyphs(label);
+
 		const auto windowSize = ImGui::GetWindowSize();
 		const auto textSize = ImGui::CalcTextSize(label);
 
@@ -100,7 +103,7 @@ namespace ImGui
 		return result;
 	}
 
-	bool AlignedImage(ID3D11ShaderResourceView* texID, const ImVec2& texture_size, const ImVec2& min, const ImVec2& max, const ImVec2& align, ImU32 colour)
+	bool AlignedImage(ID3D11ShaderResourceView* texID, const ImVec2& texture_size, const ImVec2& min, const ImVec2& max, const ImVec2& align, ImU32 colour, const ImVec2& uv0, const ImVec2& uv1)
 	{
 		ImVec2 pos = min;
 
@@ -109,7 +112,7 @@ namespace ImGui
 		if (align.y > 0.0f)
 			pos.y = ImMax(pos.y, pos.y + (max.y - pos.y - texture_size.y) * align.y);
 
-		GetCurrentWindow()->DrawList->AddImage((ImU64)texID, pos, pos + texture_size, ImVec2(0, 0), ImVec2(1, 1), colour);
+		GetCurrentWindow()->DrawList->AddImage((ImU64)texID, pos, pos + texture_size, uv0, uv1, colour);
 
 		return MANAGER(Input)->CanNavigateWithMouse() ? IsMouseHoveringRect(pos, pos + texture_size) && IsMouseClicked(0) && (ImGui::GetItemFlags() & ImGuiItemFlags_Disabled) == 0 : false;
 	}
@@ -3,6 +3,8 @@
 #include "IconsFonts.h"
 #include "Input.h"
 #include "PhotoMode/Manager.h"
+#include "ScoreItems.h"
+#include "TrigramIndex.h"
 
 namespace ImGui
 {
@@ -20,7 +22,7 @@ namespace ImGui
 	//
 	// Posted in issue: https://github.com/ocornut/imgui/issues/1658#issuecomment-1086193100
 
-	bool ComboWithFilter(const char* label, int* current_item, const std::vector<std::string>& items, int popup_max_height_in_items /*= -1*/)
+	bool ComboWithFilter(const char* label, int* current_item, std::span<const std::string> items, int popup_max_height_in_items /*= -1*/, const TrigramIndex* a_index /*= nullptr*/, const std::vector<std::uint32_t>* a_subset /*= nullptr*/)
 	{
 		const bool allow_repeat = ImGuiInputFlags_Repeat;
 
@@ -30,12 +32,17 @@ namespace ImGui
 		if (window->SkipItems)
 			return false;
 
-		int items_count = static_cast<int>(items.size());
+		int items_count = static_cast<int>(a_subset ? a_subset->size() : items.size());
+
+		const auto get_item = [&](int i) -> const std::string& {
+			return a_subset ? items[(*a_subset)[i]] : items[i];
+		};
 
-		// Could use imgui Items_ getters to support more input formats.
 		const char* preview_value = NULL;
-		if (*current_item >= 0 && *current_item < items_count)
-			preview_value = items[*current_item].c_str();
+		if (*current_item >= 0 && *current_item < items_count) {
+			preview_value = get_item(*current_item).c_str();
+			MANAGER(IconFont)->AddGlyphs(get_item(*current_item));
+		}
 
 		static int  focus_idx = -1;
 		static char pattern_buffer[256] = { 0 };
@@ -49,21 +56,58 @@ namespace ImGui
 
 		int show_count = items_count;
 
-		std::vector<std::pair<int, double>> itemScoreVector;
+		// scores are kept until the pattern or list changes, only one popup is open at a time
+		struct FilterCache
+		{
+			ImGuiID                           id{ 0 };
+			const std::string*                items{ nullptr };
+			const std::vector<std::uint32_t>* subset{ nullptr };
+			std::size_t                       itemCount{ 0 };
+			std::string                       pattern{};
+			std::vector<int>                  matches{};
+			std::vector<ItemScore>            scores{};
+			std::size_t                       ranked{ 0 };
+		};
+		static FilterCache filter_cache;
+
+		constexpr double      min_score = 65.0;
+		constexpr std::size_t rank_ahead = 64;  // rows ranked past the last one shown, sorting the rest waits until it's scrolled to
+
+		auto&      itemScoreVector = filter_cache.scores;
+		const auto rank_rows = [&](int a_row) {
+			RankScores(itemScoreVector, filter_cache.ranked, static_cast<std::size_t>(std::max(a_row, 0)) + rank_ahead);
+		};
 		if (is_filtering) {
 			// Filter before opening to ensure we show the correct size window.
 			// We won't get in here unless the popup is open.
-			for (int i = 0; i < items_count; i++) {
-				auto score = rapidfuzz::fuzz::partial_token_ratio(pattern_buffer, items[i].c_str());
-				if (score >= 65.0) {
-					itemScoreVector.push_back(std::make_pair(i, score));
+			const std::string_view pattern(pattern_buffer);
+			const bool             same_list = filter_cache.id == id && filter_cache.items == items.data() && filter_cache.subset == a_subset && filter_cache.itemCount == static_cast<std::size_t>(items_count);
+
+			if (!same_list || filter_cache.pattern != pattern) {
+				// typing more only narrows the matches, so rescore the previous ones
+				const bool refine = same_list && !filter_cache.pattern.empty() && pattern.starts_with(filter_cache.pattern);
+
+				// otherwise only items sharing trigrams with the pattern are scored
+				std::optional<std::vector<int>> candidates;
+				if (!refine && a_index && a_index->IsBuilt()) {
+					candidates = a_index->Query(pattern, a_subset);
 				}
+
+				auto [matches, scores, ranked] = ScoreItems(pattern, get_item, items_count, refine ? &filter_cache.matches : (candidates ? &*candidates : nullptr), min_score, rank_ahead);
+
+				filter_cache.id = id;
+				filter_cache.items = items.data();
+				filter_cache.subset = a_subset;
+				filter_cache.itemCount = items_count;
+				filter_cache.pattern = pattern;
+				filter_cache.matches = std::move(matches);
+				filter_cache.scores = std::move(scores);
+				filter_cache.ranked = ranked;
 			}
-			std::ranges::sort(itemScoreVector, [](const auto& a, const auto& b) {
-				return (b.second < a.second);
-			});
+
+			// a focused item outside the ranked rows would move once they're ranked
 			const int current_score_idx = IndexOfKey(itemScoreVector, focus_idx);
-			if (current_score_idx < 0 && !itemScoreVector.empty()) {
+			if ((current_score_idx < 0 || current_score_idx >= static_cast<int>(filter_cache.ranked)) && !itemScoreVector.empty()) {
 				focus_idx = itemScoreVector[0].first;
 			}
 			show_count = static_cast<int>(itemScoreVector.size());
@@ -86,6 +130,9 @@ namespace ImGui
 		if (!is_already_open) {
 			focus_idx = *current_item;
 			memset(pattern_buffer, 0, IM_ARRAYSIZE(pattern_buffer));
+
+			// the list may have been rebuilt in place since it was last filtered
+			filter_cache = {};
 		}
 
 		ImGui::PushStyleColor(ImGuiCol_FrameBg, GetUserStyleColorVec4(USER_STYLE::kComboBoxTextBox));
@@ -95,7 +142,9 @@ namespace ImGui
 		// Filter input
 		if (!is_already_open)
 			ImGui::SetKeyboardFocusHere();
-		InputText("##ComboWithFilter_inputText", pattern_buffer, 256, ImGuiInputTextFlags_AutoSelectAll);
+		if (InputText("##ComboWithFilter_inputText", pattern_buffer, 256, ImGuiInputTextFlags_AutoSelectAll)) {
+			MANAGER(IconFont)->AddGlyphs(pattern_buffer);
+		}
 
 		ImGui::PopStyleColor(3);
 
@@ -117,6 +166,7 @@ namespace ImGui
 				if (current_score_idx >= 0) {
 					const int count = static_cast<int>(itemScoreVector.size());
 					current_score_idx = ImClamp(current_score_idx + move_delta, 0, count - 1);
+					rank_rows(current_score_idx);
 					focus_idx = itemScoreVector[current_score_idx].first;
 				}
 			} else {
@@ -134,26 +184,39 @@ namespace ImGui
 
 		ImGui::PushStyleColor(ImGuiCol_NavCursor, ImVec4());
 		if (ImGui::BeginListBox("##ComboWithFilter_itemList", size)) {
-			for (int i = 0; i < show_count; i++) {
-				int idx = is_filtering ? itemScoreVector[i].first : i;
-				PushID(reinterpret_cast<void*>(static_cast<intptr_t>(idx)));
-				const bool  item_selected = (idx == focus_idx);
-				const char* item_text = items[idx].c_str();
-				if (Selectable(item_text, item_selected)) {
-					value_changed = true;
-					*current_item = idx;
-					CloseCurrentPopup();
-					RE::PlaySound("UIMenuFocus");
+			// only visible rows are submitted, plus the focused one so it can be scrolled to
+			ImGuiListClipper clipper;
+			clipper.Begin(show_count);
+			if (const int focus_row = is_filtering ? IndexOfKey(itemScoreVector, focus_idx) : focus_idx; focus_row >= 0 && focus_row < show_count) {
+				clipper.IncludeItemByIndex(focus_row);
+			}
+			while (clipper.Step()) {
+				if (is_filtering) {
+					rank_rows(clipper.DisplayEnd);
 				}
+				for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++) {
+					int idx = is_filtering ? itemScoreVector[i].first : i;
+					PushID(reinterpret_cast<void*>(static_cast<intptr_t>(idx)));
+					const bool  item_selected = (idx == focus_idx);
+					const char* item_text = get_item(idx).c_str();
+					// glyphs of rows scrolled into view are baked next frame
+					MANAGER(IconFont)->AddGlyphs(get_item(idx));
+					if (Selectable(item_text, item_selected)) {
+						value_changed = true;
+						*current_item = idx;
+						CloseCurrentPopup();
+						RE::PlaySound("UIMenuFocus");
+					}
 
-				if (item_selected) {
-					SetItemDefaultFocus();
-					// SetItemDefaultFocus doesn't work so also check IsWindowAppearing.
-					if (move_delta != 0 || IsWindowAppearing()) {
-						SetScrollHereY();
+					if (item_selected) {
+						SetItemDefaultFocus();
+						// SetItemDefaultFocus doesn't work so also check IsWindowAppearing.
+						if (move_delta != 0 || IsWindowAppearing()) {
+							SetScrollHereY();
+						}
 					}
+					PopID();
 				}
-				PopID();
 			}
 			ImGui::EndListBox();
 
@@ -194,7 +257,8 @@ namespace ImGui
 
 			AlignForWidth(checkbox->size.x);
 
-			FramelessImageButton(newLabel.c_str(), (ImTextureID)(*a_toggle ? checkboxFilled->srView.Get() : checkbox->srView.Get()), checkbox->size, ImVec2(), ImVec2(1, 1), ImVec4(),
+			const auto icon = *a_toggle ? checkboxFilled : checkbox;
+			FramelessImageButton(newLabel.c_str(), (ImTextureID)icon->srView.Get(), checkbox->size, icon->uv0, icon->uv1, ImVec4(),
 				IsWidgetFocused(newLabel) ? ImVec4(1, 1, 1, 1) : GetUserStyleColorVec4(USER_STYLE::kIconDisabled));
 		}
 		EndGroup();
@@ -218,6 +282,8 @@ namespace ImGui
 		if (window->SkipItems)
 			return { false, false, false };
 
+		MANAGER(IconFont)->AddGlyphs(centerText);
+
 		ImGuiContext&     g = *GImGui;
 		const ImGuiStyle& style = g.Style;
 		const ImGuiID     id = window->GetID(label);
@@ -263,8 +329,8 @@ namespace ImGui
 
 		const auto color = hovered ? IM_COL32_WHITE : GetUserStyleColorU32(USER_STYLE::kIconDisabled);
 
-		auto hoveringLeft = AlignedImage(leftArrow->srView.Get(), leftArrow->size, frame_bb.Min, frame_bb.Max, ImVec2(0, 0.5f), color);
-		auto hoveringRight = AlignedImage(rightArrow->srView.Get(), rightArrow->size, frame_bb.Min, frame_bb.Max, ImVec2(1.0, 0.5f), color);
+		auto hoveringLeft = AlignedImage(leftArrow->srView.Get(), leftArrow->size, frame_bb.Min, frame_bb.Max, ImVec2(0, 0.5f), color, leftArrow->uv0, leftArrow->uv1);
+		auto hoveringRight = AlignedImage(rightArrow->srView.Get(), rightArrow->size, frame_bb.Min, frame_bb.Max, ImVec2(1.0, 0.5f), color, rightArrow->uv0, rightArrow->uv1);
 
 		return { hovered, hoveringLeft, hoveringRight };
 	}
@@ -5,7 +5,11 @@
 
 namespace ImGui
 {
-	bool ComboWithFilter(const char* label, int* current_item, const std::vector<std::string>& items, int popup_max_height_in_items = -1);
+	class TrigramIndex;
+
+	// a_subset, if set, lists only those items (current_item is then a position in a_subset)
+	// a_index, if built over items, narrows the candidates before fuzzy scoring
+	bool ComboWithFilter(const char* label, int* current_item, std::span<const std::string> items, int popup_max_height_in_items = -1, const TrigramIndex* a_index = nullptr, const std::vector<std::uint32_t>* a_subset = nullptr);
 
 	bool CheckBox(const char* label, bool* a_toggle);
 
@@ -60,6 +60,9 @@ using ComPtr = Microsoft::WRL::ComPtr<T>;
 template <class K, class D>
 using Map = ankerl::unordered_dense::map<K, D>;
 
+template <class K>
+using Set = ankerl::unordered_dense::set<K>;
+
 struct string_hash
 {
 	using is_transparent = void;  // enable heterogeneous overloads
@@ -74,6 +77,8 @@ struct string_hash
 template <class D>
 using StringMap = ankerl::unordered_dense::map<std::string, D, string_hash, std::equal_to<>>;
 
+using StringSet = ankerl::unordered_dense::set<std::string, string_hash, std::equal_to<>>;
+
 namespace stl
 {
 	using namespace SKSE::stl;
@@ -128,6 +133,9 @@ namespace stl
 #	define OFFSET(se, ae) se
 #endif
 
-#include "Cache.h"
+// headless tests only build game-independent sources, Cache resolves game addresses at startup
+#ifndef PHOTOMODE_HEADLESS
+#	include "Cache.h"
+#endif
 #include "Translation.h"
 #include "Version.h"
@@ -30,6 +30,8 @@ namespace PhotoMode
 		freeCameraSpeed = static_cast<float>(a_ini.GetDoubleValue("Settings", "fFreeCameraTranslationSpeed", freeCameraSpeed));
 		freezeTimeOnStart = a_ini.GetBoolValue("Settings", "bFreezeTimeOnStart", freezeTimeOnStart);
 		openFromPauseMenu = a_ini.GetBoolValue("Settings", "bOpenFromPauseMenu", openFromPauseMenu);
+
+		overlaysTab.LoadMCMSettings(a_ini);
 	}
 
 	bool Manager::IsValid()
@@ -224,6 +226,8 @@ namespace PhotoMode
 		MANAGER(Input)->ToggleCursor(false);
 		MANAGER(Input)->ResetInputDevices();
 
+		MANAGER(IconFont)->SaveFontCache();
+
 		activated = false;
 		if (activeGlobal) {
 			activeGlobal->value = 0.0f;
@@ -281,6 +285,10 @@ namespace PhotoMode
 		if (tabIndex == -1 || tabIndex == kOverlays) {
 			overlaysTab.RevertOverlays();
 		}
+		// Gallery
+		if (tabIndex == -1 || tabIndex == kGallery) {
+			galleryTab.Release();
+		}
 
 		if (a_deactivate) {
 			// reset UI
@@ -386,7 +394,7 @@ namespace PhotoMode
 		resetRootIdle = RE::TESForm::LookupByEditorID<RE::TESIdleForm>("ResetRoot");
 	}
 
-	std::pair<ImGui::Texture*, float> Manager::GetOverlay() const
+	std::pair<std::shared_ptr<const DirectX::Image>, float> Manager::GetOverlay() const
 	{
 		return overlaysTab.GetCurrentOverlay();
 	}
@@ -553,6 +561,9 @@ namespace PhotoMode
 					case TAB_TYPE::kOverlays:
 						overlaysTab.Draw();
 						break;
+					case TAB_TYPE::kGallery:
+						galleryTab.Draw();
+						break;
 					default:
 						break;
 					}
@@ -5,6 +5,7 @@
 #include "Tabs/Camera.h"
 #include "Tabs/Character.h"
 #include "Tabs/Filters.h"
+#include "Tabs/Gallery.h"
 #include "Tabs/Overlays.h"
 #include "Tabs/Time.h"
 
@@ -51,8 +52,8 @@ namespace PhotoMode
 		void UpdateENBParams();
 		void RevertENBParams();
 
-		void                              OnDataLoad();
-		std::pair<ImGui::Texture*, float> GetOverlay() const;
+		void                                                    OnDataLoad();
+		std::pair<std::shared_ptr<const DirectX::Image>, float> GetOverlay() const;
 
 		bool IsCursorHoveringOverWindow() const;
 
@@ -63,7 +64,8 @@ namespace PhotoMode
 			kTime,
 			kCharacter,
 			kFilters,
-			kOverlays
+			kOverlays,
+			kGallery
 		};
 
 		// kMenu | kActivate | kJumping
@@ -74,16 +76,18 @@ namespace PhotoMode
 			"$PM_TimeWeather",
 			"$PM_Player",
 			"$PM_Filters",
-			"$PM_Overlays"
+			"$PM_Overlays",
+			"$PM_Gallery"
 		};
 		static constexpr std::array tabIcons = {
 			ICON_FA_CAMERA,
 			ICON_FA_CLOCK,
 			ICON_FA_PERSON,
 			ICON_FA_CIRCLE_HALF_STROKE,
-			ICON_FA_IMAGE
+			ICON_FA_IMAGE,
+			ICON_FA_IMAGES
 		};
-		static constexpr std::array tabResetNotifs = { "$PM_ResetNotifCamera", "$PM_ResetNotifTime", "$PM_ResetNotifPlayer", "$PM_ResetNotifFilters", "$PM_ResetNotifOverlays" };
+		static constexpr std::array tabResetNotifs = { "$PM_ResetNotifCamera", "$PM_ResetNotifTime", "$PM_ResetNotifPlayer", "$PM_ResetNotifFilters", "$PM_ResetNotifOverlays", "$PM_ResetNotifGallery" };
 
 		static void        TogglePlayerControls(bool a_enable);
 		void               DrawControls();
@@ -113,6 +117,7 @@ namespace PhotoMode
 
 		Filters  filterTab;
 		Overlays overlaysTab;
+		Gallery  galleryTab;
 
 		bool updateKeyboardFocus{ false };
 
@@ -0,0 +1,485 @@
+#include "Gallery.h"
+
+#include "ImGui/Widgets.h"
+#include "Input.h"
+#include "Screenshots/Manager.h"
+
+namespace PhotoMode
+{
+	Gallery::~Gallery()
+	{
+		StopWorker();
+	}
+
+	std::vector<Gallery::Item> Gallery::ScanItems(SOURCE a_source, std::filesystem::path a_photoDirectory)
+	{
+		std::filesystem::path folder;
+		std::string_view      extension;
+
+		switch (a_source) {
+		case SOURCE::kScreenshots:
+			folder = Screenshot::screenshotFolder;
+			extension = ".dds"sv;
+			break;
+		case SOURCE::kPaintings:
+			folder = Screenshot::paintingFolder;
+			extension = ".dds"sv;
+			break;
+		default:
+			folder = std::move(a_photoDirectory);
+			extension = ".png"sv;
+			break;
+		}
+
+		std::vector<Item> items;
+
+		std::error_code ec;
+		for (const auto& entry : std::filesystem::directory_iterator(folder, ec)) {
+			if (!entry.is_regular_file(ec)) {
+				continue;
+			}
+
+			const auto& path = entry.path();
+			if (path.extension() != extension) {
+				continue;
+			}
+
+			const auto size = static_cast<std::uint64_t>(entry.file_size(ec));
+			const auto mtime = Screenshot::Manifest::GetLastWriteTime(path);
+			const auto key = ankerl::unordered_dense::hash<std::string_view>{}(std::format("{}|{}|{}", path.string(), size, mtime));
+
+			items.emplace_back(path, path.stem().string(), mtime, key);
+		}
+
+		// newest first
+		std::ranges::sort(items, std::greater{}, &Item::mtime);
+
+		return items;
+	}
+
+	std::filesystem::path Gallery::GetCacheDirectory()
+	{
+		static std::filesystem::path path{};
+		if (path.empty()) {
+			if (auto directory = logger::log_directory()) {
+				directory->remove_filename();
+				*directory /= "Saves\\PhotoMode\\Thumbnails"sv;
+				path = *directory;
+			}
+		}
+		return path;
+	}
+
+	void Gallery::PruneCache(const std::filesystem::path& a_photoDirectory)
+	{
+		// keys of every thumbnail that can still be shown; renamed, edited or deleted files leave theirs behind
+		Set<std::uint64_t> liveKeys;
+		for (const auto source : { SOURCE::kPhotos, SOURCE::kScreenshots, SOURCE::kPaintings }) {
+			for (const auto& item : ScanItems(source, a_photoDirectory)) {
+				liveKeys.insert(item.key);
+			}
+		}
+
+		std::error_code ec;
+		for (const auto& entry : std::filesystem::directory_iterator(GetCacheDirectory(), ec)) {
+			const auto& path = entry.path();
+			if (!entry.is_regular_file(ec) || path.extension() != ".dds") {
+				continue;
+			}
+			const auto    stem = path.stem().string();
+			std::uint64_t key = 0;
+			if (const auto [ptr, errc] = std::from_chars(stem.data(), stem.data() + stem.size(), key, 16); errc != std::errc{} || ptr != stem.data() + stem.size()) {
+				continue;  // not ours
+			}
+			if (!liveKeys.contains(key)) {
+				std::filesystem::remove(path, ec);
+			}
+		}
+	}
+
+	bool Gallery::LoadThumbnail(const Request& a_request, DirectX::ScratchImage& a_outImage)
+	{
+		const auto cachePath = GetCacheDirectory() / std::format("{:016X}.dds", a_request.key);
+		if (SUCCEEDED(DirectX::LoadFromDDSFile(cachePath.c_str(), DirectX::DDS_FLAGS_NONE, nullptr, a_outImage))) {
+			return true;
+		}
+
+		DirectX::ScratchImage sourceImage;
+
+		auto hr = a_request.path.extension() == ".dds" ?
+		              DirectX::LoadFromDDSFile(a_request.path.c_str(), DirectX::DDS_FLAGS_NONE, nullptr, sourceImage) :
+		              DirectX::LoadFromWICFile(a_request.path.c_str(), DirectX::WIC_FLAGS_IGNORE_SRGB, nullptr, sourceImage);
+		if (FAILED(hr)) {
+			return false;
+		}
+
+		if (DirectX::IsCompressed(sourceImage.GetMetadata().format)) {
+			DirectX::ScratchImage decompressedImage;
+			if (FAILED(DirectX::Decompress(*sourceImage.GetImage(0, 0, 0), DXGI_FORMAT_R8G8B8A8_UNORM, decompressedImage))) {
+				return false;
+			}
+			sourceImage = std::move(decompressedImage);
+		}
+
+		// fit inside a slot
+		const auto& metadata = sourceImage.GetMetadata();
+		const auto  scale = std::min(static_cast<float>(THUMBNAIL_WIDTH) / metadata.width, static_cast<float>(THUMBNAIL_HEIGHT) / metadata.height);
+		const auto  width = std::max<std::size_t>(static_cast<std::size_t>(metadata.width * scale), 1);
+		const auto  height = std::max<std::size_t>(static_cast<std::size_t>(metadata.height * scale), 1);
+
+		DirectX::ScratchImage resizedImage;
+		if (FAILED(DirectX::Resize(*sourceImage.GetImage(0, 0, 0), width, height, DirectX::TEX_FILTER_FANT, resizedImage))) {
+			return false;
+		}
+		sourceImage.Release();
+
+		if (resizedImage.GetMetadata().format != DXGI_FORMAT_R8G8B8A8_UNORM) {
+			if (FAILED(DirectX::Convert(*resizedImage.GetImage(0, 0, 0), DXGI_FORMAT_R8G8B8A8_UNORM, DirectX::TEX_FILTER_DEFAULT, DirectX::TEX_THRESHOLD_DEFAULT, a_outImage))) {
+				return false;
+			}
+		} else {
+			a_outImage = std::move(resizedImage);
+		}
+
+		// captures keep whatever alpha the render target had
+		const auto image = a_outImage.GetImage(0, 0, 0);
+		for (std::size_t y = 0; y < image->height; y++) {
+			auto pixel = image->pixels + (y * image->rowPitch);
+			for (std::size_t x = 0; x < image->width; x++, pixel += 4) {
+				pixel[3] = 255;
+			}
+		}
+
+		std::error_code ec;
+		std::filesystem::create_directories(cachePath.parent_path(), ec);
+		DirectX::SaveToDDSFile(*image, DirectX::DDS_FLAGS_NONE, cachePath.c_str());
+
+		return true;
+	}
+
+	void Gallery::StartWorker()
+	{
+		worker = std::jthread([this](std::stop_token a_token) {
+			ProcessRequests(std::move(a_token));
+		});
+	}
+
+	void Gallery::StopWorker()
+	{
+		if (!worker.joinable()) {
+			return;
+		}
+
+		// the worker touches this gallery's queues, so wait out the decode in progress (a single thumbnail)
+		worker.request_stop();
+		worker.join();
+	}
+
+	void Gallery::ProcessRequests(std::stop_token a_token)
+	{
+		// background mode also lowers I/O priority
+		SetThreadPriority(GetCurrentThread(), THREAD_MODE_BACKGROUND_BEGIN);
+
+		// WIC decoding needs COM on this thread
+		const auto hr = CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+
+		while (!a_token.stop_requested()) {
+			Request request;
+			{
+				std::unique_lock guard(lock);
+				if (!condition.wait(guard, a_token, [this] { return !requests.empty(); })) {
+					break;
+				}
+				// newest first, those are the rows on screen
+				request = std::move(requests.back());
+				requests.pop_back();
+			}
+
+			Result result{ request.key };
+			if (!LoadThumbnail(request, result.image)) {
+				result.image.Release();
+			}
+
+			std::scoped_lock guard(lock);
+			results.push_back(std::move(result));
+		}
+
+		if (SUCCEEDED(hr)) {
+			CoUninitialize();
+		}
+	}
+
+	bool Gallery::CreateAtlases()
+	{
+		const auto renderer = RE::BSGraphics::Renderer::GetSingleton();
+		if (!renderer) {
+			return false;
+		}
+
+		const auto device = reinterpret_cast<ID3D11Device*>(renderer->data.forwarder);
+
+		D3D11_TEXTURE2D_DESC desc{};
+		desc.Width = ATLAS_SIZE;
+		desc.Height = ATLAS_SIZE;
+		desc.MipLevels = 1;
+		desc.ArraySize = 1;
+		desc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+		desc.SampleDesc.Count = 1;
+		desc.Usage = D3D11_USAGE_DEFAULT;
+		desc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+
+		for (std::uint32_t i = 0; i < MAX_ATLASES; i++) {
+			ComPtr<ID3D11Texture2D>          atlas;
+			ComPtr<ID3D11ShaderResourceView> atlasView;
+			if (FAILED(device->CreateTexture2D(&desc, nullptr, &atlas)) || FAILED(device->CreateShaderResourceView(atlas.Get(), nullptr, &atlasView))) {
+				logger::info("Failed to create gallery atlas");
+				atlases.clear();
+				atlasViews.clear();
+				return false;
+			}
+			atlases.push_back(std::move(atlas));
+			atlasViews.push_back(std::move(atlasView));
+		}
+
+		slots.resize(MAX_ATLASES * SLOTS_PER_ATLAS);
+
+		return true;
+	}
+
+	std::size_t Gallery::AcquireSlot(const Item& a_item)
+	{
+		if (const auto it = slotMap.find(a_item.key); it != slotMap.end()) {
+			slots[it->second].lastUsedFrame = frame;
+			return it->second;
+		}
+
+		// free slot, or the least recently drawn one
+		std::size_t slotIndex = slots.size();
+		for (std::size_t i = 0; i < slots.size(); i++) {
+			if (slots[i].key == 0) {
+				slotIndex = i;
+				break;
+			}
+			if (slots[i].lastUsedFrame < frame && (slotIndex == slots.size() || slots[i].lastUsedFrame < slots[slotIndex].lastUsedFrame)) {
+				slotIndex = i;
+			}
+		}
+
+		if (slotIndex == slots.size()) {
+			return slotIndex;
+		}
+
+		auto&      slot = slots[slotIndex];
+		const auto evictedKey = slot.key;
+		if (evictedKey != 0) {
+			slotMap.erase(evictedKey);
+		}
+		slot = { a_item.key, frame };
+		slotMap.emplace(a_item.key, slotIndex);
+
+		// only thumbnails that still have a slot are decoded
+		std::uint64_t droppedKey = 0;
+		{
+			std::scoped_lock guard(lock);
+			if (evictedKey != 0) {
+				std::erase_if(requests, [&](const Request& a_request) { return a_request.key == evictedKey; });
+			}
+			requests.emplace_back(a_item.path, a_item.key);
+			if (requests.size() > MAX_PENDING_REQUESTS) {
+				droppedKey = requests.front().key;
+				requests.pop_front();
+			}
+		}
+		condition.notify_one();
+
+		// free the slot of a dropped request, it is requested again if it comes back into view
+		if (const auto it = slotMap.find(droppedKey); it != slotMap.end()) {
+			slots[it->second] = {};
+			slotMap.erase(it);
+		}
+
+		return slotIndex;
+	}
+
+	void Gallery::UploadResults()
+	{
+		std::vector<Result> completed;
+		{
+			std::scoped_lock guard(lock);
+			while (!results.empty() && completed.size() < MAX_UPLOADS_PER_FRAME) {
+				completed.push_back(std::move(results.front()));
+				results.pop_front();
+			}
+		}
+
+		if (completed.empty()) {
+			return;
+		}
+
+		const auto context = reinterpret_cast<ID3D11DeviceContext*>(RE::BSGraphics::Renderer::GetSingleton()->data.context);
+
+		for (auto& result : completed) {
+			const auto it = slotMap.find(result.key);
+			if (it == slotMap.end() || result.image.GetImageCount() == 0) {
+				continue;  // scrolled away and recycled, or not decodable
+			}
+
+			const auto slotIndex = it->second;
+			const auto localIndex = static_cast<std::uint32_t>(slotIndex % SLOTS_PER_ATLAS);
+			const auto image = result.image.GetImage(0, 0, 0);
+
+			D3D11_BOX box{};
+			box.left = (localIndex % ATLAS_COLUMNS) * THUMBNAIL_WIDTH;
+			box.top = (localIndex / ATLAS_COLUMNS) * THUMBNAIL_HEIGHT;
+			box.right = box.left + static_cast<std::uint32_t>(std::min<std::size_t>(image->width, THUMBNAIL_WIDTH));
+			box.bottom = box.top + static_cast<std::uint32_t>(std::min<std::size_t>(image->height, THUMBNAIL_HEIGHT));
+			box.back = 1;
+
+			context->UpdateSubresource(atlases[slotIndex / SLOTS_PER_ATLAS].Get(), 0, &box, image->pixels, static_cast<UINT>(image->rowPitch), 0);
+
+			auto& slot = slots[slotIndex];
+			slot.size = ImVec2(static_cast<float>(box.right - box.left), static_cast<float>(box.bottom - box.top));
+			slot.ready = true;
+		}
+	}
+
+	void Gallery::DrawThumbnail(std::size_t a_index, const ImVec2& a_cellSize)
+	{
+		const auto& item = items[a_index];
+		const auto  slotIndex = AcquireSlot(item);
+
+		ImGui::PushID(static_cast<int>(a_index));
+		const auto topLeft = ImGui::GetCursorScreenPos();
+		ImGui::InvisibleButton("##Thumbnail", a_cellSize);  // navigable, so gamepad focus scrolls the grid
+		ImGui::PopID();
+
+		const auto drawList = ImGui::GetWindowDrawList();
+		const auto bottomRight = ImVec2(topLeft.x + a_cellSize.x, topLeft.y + a_cellSize.y);
+
+		if (slotIndex < slots.size() && slots[slotIndex].ready) {
+			const auto& slot = slots[slotIndex];
+			const auto  localIndex = static_cast<std::uint32_t>(slotIndex % SLOTS_PER_ATLAS);
+
+			const auto uv0 = ImVec2(static_cast<float>((localIndex % ATLAS_COLUMNS) * THUMBNAIL_WIDTH) / ATLAS_SIZE, static_cast<float>((localIndex / ATLAS_COLUMNS) * THUMBNAIL_HEIGHT) / ATLAS_SIZE);
+			const auto uv1 = ImVec2(uv0.x + slot.size.x / ATLAS_SIZE, uv0.y + slot.size.y / ATLAS_SIZE);
+
+			const auto scale = std::min(a_cellSize.x / slot.size.x, a_cellSize.y / slot.size.y);
+			const auto imageSize = ImVec2(slot.size.x * scale, slot.size.y * scale);
+			const auto imageMin = ImVec2(topLeft.x + (a_cellSize.x - imageSize.x) * 0.5f, topLeft.y + (a_cellSize.y - imageSize.y) * 0.5f);
+
+			drawList->AddImage((ImTextureID)atlasViews[slotIndex / SLOTS_PER_ATLAS].Get(), imageMin, ImVec2(imageMin.x + imageSize.x, imageMin.y + imageSize.y), uv0, uv1);
+		} else {
+			drawList->AddRectFilled(topLeft, bottomRight, ImGui::GetColorU32(ImGuiCol_FrameBg));
+		}
+
+		if (MANAGER(Input)->CanNavigateWithMouse() ? ImGui::IsItemHovered() : ImGui::IsItemFocused()) {
+			drawList->AddRect(topLeft, bottomRight, ImGui::GetColorU32(ImGuiCol_NavCursor));
+			ImGui::SetTooltip("%s", item.name.c_str());
+		}
+	}
+
+	void Gallery::DrawGrid()
+	{
+		const auto& style = ImGui::GetStyle();
+		const auto  availWidth = ImGui::GetContentRegionAvail().x;
+
+		const auto columns = std::max<std::size_t>(static_cast<std::size_t>((availWidth + style.ItemSpacing.x) / (THUMBNAIL_WIDTH + style.ItemSpacing.x)), 1);
+		const auto cellWidth = (availWidth - style.ItemSpacing.x * (columns - 1)) / columns;
+		const auto cellSize = ImVec2(cellWidth, cellWidth * THUMBNAIL_HEIGHT / THUMBNAIL_WIDTH);
+		const auto rows = (items.size() + columns - 1) / columns;
+
+		// only visible rows are submitted, and only those request thumbnails
+		ImGuiListClipper clipper;
+		clipper.Begin(static_cast<int>(rows), cellSize.y + style.ItemSpacing.y);
+		while (clipper.Step()) {
+			for (auto row = clipper.DisplayStart; row < clipper.DisplayEnd; row++) {
+				for (std::size_t column = 0; column < columns; column++) {
+					const auto index = static_cast<std::size_t>(row) * columns + column;
+					if (index >= items.size()) {
+						break;
+					}
+					if (column > 0) {
+						ImGui::SameLine();
+					}
+					DrawThumbnail(index, cellSize);
+				}
+			}
+		}
+		clipper.End();
+	}
+
+	void Gallery::Draw()
+	{
+		const auto photoDirectory = MANAGER(Screenshot)->GetPhotoDirectory();
+		if (photoDirectory.empty()) {
+			ImGui::TextUnformatted("$PM_GalleryLoading"_T);
+			return;
+		}
+
+		if (ImGui::EnumSlider("$PM_GallerySource"_T, &source, sources)) {
+			rescan = true;
+		}
+
+		if (pendingScan.valid() && pendingScan.wait_for(0s) == std::future_status::ready) {
+			auto scannedItems = pendingScan.get();
+			if (!rescan) {
+				items = std::move(scannedItems);
+			}
+		}
+
+		// switching sources mid-scan waits for it to finish instead of blocking on the future
+		if (rescan && !pendingScan.valid()) {
+			items.clear();
+			pendingScan = std::async(std::launch::async, [source = source, photoDirectory, prune = !prunedCache]() {
+				if (prune) {
+					PruneCache(photoDirectory);
+				}
+				return ScanItems(source, photoDirectory);
+			});
+			prunedCache = true;
+			rescan = false;
+		}
+
+		if (pendingScan.valid()) {
+			ImGui::TextUnformatted("$PM_GalleryLoading"_T);
+			return;
+		}
+
+		if (items.empty()) {
+			ImGui::TextUnformatted("$PM_GalleryEmpty"_T);
+			return;
+		}
+
+		if (atlases.empty() && !CreateAtlases()) {
+			return;
+		}
+
+		if (!worker.joinable()) {
+			StartWorker();
+		}
+
+		frame++;
+
+		UploadResults();
+		DrawGrid();
+	}
+
+	void Gallery::Release()
+	{
+		StopWorker();
+
+		{
+			std::scoped_lock guard(lock);
+			requests.clear();
+			results.clear();
+		}
+
+		slots.clear();
+		slotMap.clear();
+		atlasViews.clear();
+		atlases.clear();
+
+		items.clear();
+		rescan = true;
+	}
+}
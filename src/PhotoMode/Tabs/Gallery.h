@@ -0,0 +1,100 @@
+#pragma once
+
+namespace PhotoMode
+{
+	// Grid of past photos and load screen textures.
+	// Thumbnails are decoded on a background thread, cached on disk by file identity and uploaded into a fixed pool of atlas slots,
+	// so only visible rows cost anything and GPU memory stays the same no matter how many photos there are.
+	class Gallery
+	{
+	public:
+		Gallery() = default;
+		~Gallery();
+
+		Gallery(const Gallery&) = delete;
+		Gallery& operator=(const Gallery&) = delete;
+
+		void Draw();
+		void Release();  // drops atlases and pending work, rescans on the next Draw
+
+	private:
+		enum class SOURCE : std::uint32_t
+		{
+			kPhotos,
+			kScreenshots,
+			kPaintings
+		};
+
+		static constexpr std::array sources = { "$PM_GalleryPhotos", "$PM_GalleryScreenshots", "$PM_GalleryPaintings" };
+
+		static constexpr std::uint32_t THUMBNAIL_WIDTH{ 192 };
+		static constexpr std::uint32_t THUMBNAIL_HEIGHT{ 108 };
+		static constexpr std::uint32_t ATLAS_SIZE{ 2048 };
+		static constexpr std::uint32_t ATLAS_COLUMNS{ ATLAS_SIZE / THUMBNAIL_WIDTH };
+		static constexpr std::uint32_t SLOTS_PER_ATLAS{ ATLAS_COLUMNS * (ATLAS_SIZE / THUMBNAIL_HEIGHT) };
+		static constexpr std::uint32_t MAX_ATLASES{ 2 };
+		static constexpr std::uint32_t MAX_UPLOADS_PER_FRAME{ 4 };
+		static constexpr std::size_t   MAX_PENDING_REQUESTS{ 64 };  // about a screen of thumbnails, older rows were scrolled past
+
+		struct Item
+		{
+			std::filesystem::path path;
+			std::string           name;
+			std::int64_t          mtime;
+			std::uint64_t         key;  // path + size + mtime
+		};
+
+		struct Slot
+		{
+			std::uint64_t key{ 0 };
+			std::uint64_t lastUsedFrame{ 0 };
+			ImVec2        size{};  // thumbnail size inside the slot, aspect preserved
+			bool          ready{ false };
+		};
+
+		struct Request
+		{
+			std::filesystem::path path;
+			std::uint64_t         key;
+		};
+
+		struct Result
+		{
+			std::uint64_t         key;
+			DirectX::ScratchImage image;  // empty if decoding failed
+		};
+
+		static std::vector<Item>     ScanItems(SOURCE a_source, std::filesystem::path a_photoDirectory);
+		static std::filesystem::path GetCacheDirectory();
+		static void                  PruneCache(const std::filesystem::path& a_photoDirectory);  // drops thumbnails of photos that no longer exist
+		static bool                  LoadThumbnail(const Request& a_request, DirectX::ScratchImage& a_outImage);
+
+		void        StartWorker();
+		void        StopWorker();
+		void        ProcessRequests(std::stop_token a_token);
+		bool        CreateAtlases();
+		std::size_t AcquireSlot(const Item& a_item);
+		void        UploadResults();
+		void        DrawGrid();
+		void        DrawThumbnail(std::size_t a_index, const ImVec2& a_cellSize);
+
+		// members
+		SOURCE                         source{ SOURCE::kPhotos };
+		std::future<std::vector<Item>> pendingScan{};
+		std::vector<Item>              items{};
+		bool                           rescan{ true };
+		bool                           prunedCache{ false };  // once per session, with the first scan
+
+		std::vector<ComPtr<ID3D11Texture2D>>          atlases{};
+		std::vector<ComPtr<ID3D11ShaderResourceView>> atlasViews{};
+		std::vector<Slot>                             slots{};
+		Map<std::uint64_t, std::size_t>               slotMap{};
+		std::uint64_t                                 frame{ 0 };
+
+		std::mutex                  lock{};
+		std::condition_variable_any condition{};
+		std::deque<Request>         requests{};
+		std::deque<Result>          results{};
+		std::jthread                worker{};
+	};
+}
@@ -4,6 +4,17 @@
 
 namespace PhotoMode
 {
+	Overlays::~Overlays()
+	{
+		StopWorker();
+	}
+
+	void Overlays::LoadMCMSettings(const CSimpleIniA& a_ini)
+	{
+		cacheBudget = static_cast<std::size_t>(std::max(a_ini.GetLongValue("Settings", "iOverlayCacheMB", 512), 0L)) << 20;
+		EvictOverlays();
+	}
+
 	void Overlays::LoadOverlays()
 	{
 		const std::filesystem::path overlaysPath(R"(Data\Interface\PhotoMode\Overlays)");
@@ -31,20 +42,23 @@ namespace PhotoMode
 			}
 		}
 
+		// index only, overlays are decoded when first selected
 		for (auto& [folder, files] : imagePaths) {
 			for (auto& [path, fileName] : files) {
-				overlays[folder].emplace(fileName, ImGui::Texture(path));
+				overlays[folder].emplace(fileName, static_cast<std::uint32_t>(overlayPaths.size()));
+				overlayPaths.push_back(std::move(path));
 			}
 		}
 
 		hasOverlays = !overlays.empty();
 
+		// stats every overlay, off the loading thread
+		std::jthread([paths = overlayPaths]() {
+			PruneCache(paths);
+		}).detach();
+
 		if (hasOverlays) {
-			for (auto& files : overlays | std::views::values) {
-				for (auto& overlay : files | std::views::values) {
-					overlay.Load(true);
-				}
-			}
+			logger::info("Indexed {} overlays", overlayPaths.size());
 
 			std::uint32_t index = 0;
 
@@ -63,7 +77,8 @@ namespace PhotoMode
 
 	void Overlays::RevertOverlays()
 	{
-		cachedOverlay = nullptr;
+		currentOverlay = {};
+		wantedOverlay = INVALID_ID;
 		updateOverlay = false;
 
 		folders.index = 0;
@@ -74,21 +89,280 @@ namespace PhotoMode
 		alpha = 1.0f;
 	}
 
-	ImGui::Texture* Overlays::UpdateOverlay()
+	std::filesystem::path Overlays::GetCacheDirectory()
+	{
+		static std::filesystem::path path{};
+		if (path.empty()) {
+			if (auto directory = logger::log_directory()) {
+				directory->remove_filename();
+				*directory /= "Saves\\PhotoMode\\Overlays"sv;
+				path = *directory;
+			}
+		}
+		return path;
+	}
+
+	Texture::PixelBlob::Key Overlays::GetCacheKey(const std::filesystem::path& a_path)
+	{
+		std::error_code ec;
+		const auto      size = std::filesystem::file_size(a_path, ec);
+		const auto      mtime = std::filesystem::last_write_time(a_path, ec).time_since_epoch().count();
+		const auto      screenSize = RE::BSGraphics::Renderer::GetScreenSize();
+
+		return {
+			ankerl::unordered_dense::hash<std::string_view>{}(std::format("{}|{}|{}", a_path.string(), size, mtime)),
+			screenSize.width,
+			screenSize.height,
+			OVERLAY_FORMAT
+		};
+	}
+
+	void Overlays::PruneCache(const std::vector<std::wstring>& a_paths)
+	{
+		StringSet liveFiles;
+		for (const auto& path : a_paths) {
+			liveFiles.insert(GetCacheKey(path).GetFileName());
+		}
+
+		std::error_code ec;
+		for (const auto& entry : std::filesystem::directory_iterator(GetCacheDirectory(), ec)) {
+			// .tmp files may be a blob the worker is writing right now
+			if (entry.is_regular_file(ec) && entry.path().extension() != ".tmp" && !liveFiles.contains(entry.path().filename().string())) {
+				std::filesystem::remove(entry.path(), ec);
+			}
+		}
+	}
+
+	bool Overlays::LoadOverlay(ImGui::Texture& a_texture, std::optional<PixelSource>& a_outSource)
+	{
+		const auto key = GetCacheKey(a_texture.path);
+		const auto cachePath = GetCacheDirectory() / key.GetFileName();
+
+		if (auto blob = Texture::PixelBlob::Open(cachePath, key)) {
+			a_texture.SetPixels(std::move(blob));
+			a_outSource.emplace(cachePath, key);
+			return true;
+		}
+
+		if (!a_texture.Decode(true)) {
+			return false;
+		}
+
+		// converted once here rather than at every capture
+		if (a_texture.image->GetMetadata().format != OVERLAY_FORMAT) {
+			auto converted = std::make_shared<DirectX::ScratchImage>();
+			if (FAILED(DirectX::Convert(*a_texture.GetImage(), OVERLAY_FORMAT, DirectX::TEX_FILTER_DEFAULT, DirectX::TEX_THRESHOLD_DEFAULT, *converted))) {
+				return false;
+			}
+			a_texture.image = std::move(converted);
+		}
+
+		if (Texture::PixelBlob::Write(cachePath, key, *a_texture.GetImage())) {
+			a_outSource.emplace(cachePath, key);
+		} else {
+			logger::info("Failed to cache overlay pixels to {}", cachePath.string());
+		}
+
+		return true;
+	}
+
+	std::uint32_t Overlays::GetOverlayID(std::uint32_t a_fileIndex)
 	{
+		auto& files = GetFiles();
+		if (a_fileIndex == 0 || a_fileIndex >= files.names.size()) {
+			return INVALID_ID;
+		}
+
 		if (const auto it = overlays.find(folders.get_file()); it != overlays.end()) {
-			const auto file = GetFiles().get_file();
-			if (const auto fileIt = it->second.find(file); fileIt != it->second.end()) {
-				return &fileIt->second;
+			if (const auto fileIt = it->second.find(files.names[a_fileIndex]); fileIt != it->second.end()) {
+				return fileIt->second;
+			}
+		}
+
+		return INVALID_ID;
+	}
+
+	void Overlays::SelectOverlay()
+	{
+		const auto index = GetFiles().index;
+
+		wantedOverlay = GetOverlayID(index);
+		currentOverlay = {};
+
+		if (wantedOverlay != INVALID_ID) {
+			if (const auto it = cache.find(wantedOverlay); it != cache.end()) {
+				it->second.lastUsed = ++useCounter;
+				currentOverlay = it->second;
+			} else {
+				RequestOverlay(wantedOverlay, false);
 			}
 		}
 
-		return nullptr;
+		// the slider moves one step at a time
+		RequestOverlay(GetOverlayID(index - 1), true);
+		RequestOverlay(GetOverlayID(index + 1), true);
 	}
 
-	std::pair<ImGui::Texture*, float> Overlays::GetCurrentOverlay() const
+	void Overlays::RequestOverlay(std::uint32_t a_id, bool a_prefetch)
 	{
-		return { cachedOverlay, alpha };
+		if (a_id == INVALID_ID || cache.contains(a_id) || !pending.emplace(a_id).second) {
+			return;
+		}
+
+		if (!worker.joinable()) {
+			StartWorker();
+		}
+
+		{
+			std::scoped_lock guard(lock);
+			// the worker takes from the back, prefetches wait behind the selected overlay
+			if (a_prefetch) {
+				requests.emplace_front(a_id, overlayPaths[a_id]);
+			} else {
+				requests.emplace_back(a_id, overlayPaths[a_id]);
+			}
+		}
+		condition.notify_one();
+	}
+
+	void Overlays::StartWorker()
+	{
+		worker = std::jthread([this](std::stop_token a_token) {
+			ProcessRequests(std::move(a_token));
+		});
+	}
+
+	void Overlays::StopWorker()
+	{
+		if (!worker.joinable()) {
+			return;
+		}
+
+		// the worker fills this object's queues, so wait out the decode in progress
+		worker.request_stop();
+		worker.join();
+	}
+
+	void Overlays::ProcessRequests(std::stop_token a_token)
+	{
+		// background mode also lowers I/O priority
+		SetThreadPriority(GetCurrentThread(), THREAD_MODE_BACKGROUND_BEGIN);
+
+		// WIC decoding needs COM on this thread
+		const auto hr = CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+
+		while (!a_token.stop_requested()) {
+			Request request;
+			{
+				std::unique_lock guard(lock);
+				if (!condition.wait(guard, a_token, [this] { return !requests.empty(); })) {
+					break;
+				}
+				request = std::move(requests.back());
+				requests.pop_back();
+			}
+
+			auto                       texture = std::make_shared<ImGui::Texture>(request.path);
+			std::optional<PixelSource> source;
+			if (!LoadOverlay(*texture, source)) {
+				logger::info("Failed to decode overlay {}", stl::utf16_to_utf8(request.path).value_or(""s));
+				texture.reset();
+			}
+
+			std::scoped_lock guard(lock);
+			results.emplace_back(request.id, std::move(texture), std::move(source));
+		}
+
+		if (SUCCEEDED(hr)) {
+			CoUninitialize();
+		}
+	}
+
+	void Overlays::UploadResults()
+	{
+		// one upload per frame, a screen sized texture is tens of MB
+		Result result;
+		{
+			std::scoped_lock guard(lock);
+			if (results.empty()) {
+				return;
+			}
+			result = std::move(results.front());
+			results.pop_front();
+		}
+
+		pending.erase(result.id);
+
+		if (!result.texture || !result.texture->Upload()) {
+			return;
+		}
+
+		// captures page the pixels back in from the cache, so only the GPU texture stays resident
+		auto bytes = result.texture->GetImage()->slicePitch;
+		if (result.source) {
+			result.texture->ReleasePixels();
+		} else {
+			bytes *= 2;
+		}
+
+		auto& entry = cache.insert_or_assign(result.id, CacheEntry{ result.texture, std::move(result.source), bytes, ++useCounter }).first->second;
+		cacheBytes += bytes;
+
+		if (result.id == wantedOverlay) {
+			currentOverlay = entry;
+		}
+
+		EvictOverlays();
+	}
+
+	void Overlays::EvictOverlays()
+	{
+		while (cacheBytes > cacheBudget) {
+			auto lru = cache.end();
+			for (auto it = cache.begin(); it != cache.end(); ++it) {
+				if (it->first != wantedOverlay && (lru == cache.end() || it->second.lastUsed < lru->second.lastUsed)) {
+					lru = it;
+				}
+			}
+			if (lru == cache.end()) {
+				break;
+			}
+
+			cacheBytes -= lru->second.bytes;
+			cache.erase(lru);
+		}
+	}
+
+	std::pair<std::shared_ptr<const DirectX::Image>, float> Overlays::GetCurrentOverlay() const
+	{
+		const auto& [texture, source, bytes, lastUsed] = currentOverlay;
+		if (!texture) {
+			return { nullptr, alpha };
+		}
+
+		// kept CPU copy, caching failed
+		if (texture->image) {
+			return { std::shared_ptr<const DirectX::Image>(texture->image, texture->GetImage()), alpha };
+		}
+
+		if (source) {
+			if (auto blob = Texture::PixelBlob::Open(source->path, source->key)) {
+				const auto image = &blob->GetImage();
+				return { std::shared_ptr<const DirectX::Image>(std::move(blob), image), alpha };
+			}
+			logger::info("Failed to map overlay pixels from {}, decoding the overlay again", source->path.string());
+		}
+
+		// cache file deleted or replaced since upload, decode the source and rewrite it
+		auto                       decoded = std::make_shared<ImGui::Texture>(texture->path);
+		std::optional<PixelSource> decodedSource;
+		if (!LoadOverlay(*decoded, decodedSource)) {
+			logger::info("Failed to decode overlay {}", stl::utf16_to_utf8(texture->path).value_or(""s));
+			return { nullptr, alpha };
+		}
+
+		const auto image = decoded->GetImage();
+		return { std::shared_ptr<const DirectX::Image>(std::move(decoded), image), alpha };
 	}
 
 	void Overlays::Draw()
@@ -103,9 +377,12 @@ namespace PhotoMode
 						files.index = 0;
 					}
 				}
-				cachedOverlay = nullptr;
+				currentOverlay = {};
+				wantedOverlay = INVALID_ID;
 				updateOverlay = false;
 				alpha = 1.0f;
+
+				RequestOverlay(GetOverlayID(1), true);
 			}
 			ImGui::Indent();
 			{
@@ -127,13 +404,15 @@ namespace PhotoMode
 		constexpr auto topLeft = ImVec2(0.0f, 0.0f);
 		const auto static bottomRight = ImVec2(size.x, size.y);
 
+		UploadResults();
+
 		if (updateOverlay) {
 			updateOverlay = false;
-			cachedOverlay = UpdateOverlay();
+			SelectOverlay();
 		}
 
-		if (cachedOverlay) {
-			drawList->AddImage((ImTextureID)cachedOverlay->srView.Get(), topLeft, bottomRight, ImVec2(0, 0), ImVec2(1, 1), static_cast<ImU32>(ImColor(1.0f, 1.0f, 1.0f, alpha)));
+		if (currentOverlay.texture) {
+			drawList->AddImage((ImTextureID)currentOverlay.texture->srView.Get(), topLeft, bottomRight, ImVec2(0, 0), ImVec2(1, 1), static_cast<ImU32>(ImColor(1.0f, 1.0f, 1.0f, alpha)));
 		}
 	}
 }
@@ -4,14 +4,25 @@
 
 namespace PhotoMode
 {
+	// Overlays are indexed at data load and decoded on first use.
+	// Selecting one decodes it on a background thread along with its neighbours, and decoded overlays are kept in an LRU cache within a byte budget.
+	// Resized pixels are also cached on disk per screen resolution, so later sessions map them instead of decoding the PNG again.
+	// Once uploaded only the GPU texture stays resident; captures map the cached pixels of the selected overlay back in.
 	class Overlays
 	{
 	public:
+		Overlays() = default;
+		~Overlays();
+
+		Overlays(const Overlays&) = delete;
+		Overlays& operator=(const Overlays&) = delete;
+
+		void LoadMCMSettings(const CSimpleIniA& a_ini);
 		void LoadOverlays();
 		void RevertOverlays();
 
-		ImGui::Texture*                   UpdateOverlay();
-		std::pair<ImGui::Texture*, float> GetCurrentOverlay() const;
+		// pixels of the displayed overlay for blending into a capture, paged back in from the pixel cache
+		std::pair<std::shared_ptr<const DirectX::Image>, float> GetCurrentOverlay() const;
 
 		void Draw();
 		void DrawOverlays();
@@ -35,15 +46,80 @@ namespace PhotoMode
 			return folderFiles[folders.index];
 		}
 
-		// folder, file
-		StringMap<StringMap<ImGui::Texture>> overlays{};
-		ImGui::Texture*                      cachedOverlay{ nullptr };
-		bool                                 updateOverlay{ false };
-		bool                                 hasOverlays{ false };
+		using TexturePtr = std::shared_ptr<ImGui::Texture>;
+
+		static constexpr std::uint32_t INVALID_ID{ std::numeric_limits<std::uint32_t>::max() };
+		static constexpr DXGI_FORMAT   OVERLAY_FORMAT{ DXGI_FORMAT_R8G8B8A8_UNORM };  // same as captures, so blending needs no conversion
+
+		// where released pixels can be mapped back from
+		struct PixelSource
+		{
+			std::filesystem::path   path;
+			Texture::PixelBlob::Key key;
+		};
+
+		struct CacheEntry
+		{
+			TexturePtr                 texture{};
+			std::optional<PixelSource> source{};    // empty if caching failed, the CPU copy is kept instead
+			std::size_t                bytes{ 0 };  // GPU texture + CPU copy, if kept
+			std::uint64_t              lastUsed{ 0 };
+		};
+
+		struct Request
+		{
+			std::uint32_t id;
+			std::wstring  path;
+		};
+
+		struct Result
+		{
+			std::uint32_t              id;
+			TexturePtr                 texture;  // decoded but not uploaded, nullptr if decoding failed
+			std::optional<PixelSource> source;
+		};
+
+		static std::filesystem::path   GetCacheDirectory();
+		static Texture::PixelBlob::Key GetCacheKey(const std::filesystem::path& a_path);  // source file at the current screen resolution
+		static void                    PruneCache(const std::vector<std::wstring>& a_paths);  // drops pixels of removed or edited overlays and other resolutions
+		static bool                    LoadOverlay(ImGui::Texture& a_texture, std::optional<PixelSource>& a_outSource);  // from the pixel cache, or decoded, resized and cached
+
+		std::uint32_t GetOverlayID(std::uint32_t a_fileIndex);  // in the current folder, INVALID_ID for NONE
+		void          SelectOverlay();
+		void          RequestOverlay(std::uint32_t a_id, bool a_prefetch);
+
+		void StartWorker();
+		void StopWorker();
+		void ProcessRequests(std::stop_token a_token);
+		void UploadResults();
+		void EvictOverlays();
+
+		// members
+		// folder, file, overlay id
+		StringMap<StringMap<std::uint32_t>> overlays{};
+		std::vector<std::wstring>           overlayPaths{};
+		bool                                updateOverlay{ false };
+		bool                                hasOverlays{ false };
 
 		FileIndex                     folders{};
 		Map<std::uint32_t, FileIndex> folderFiles{};
 
 		float alpha{ 1.0f };
+
+		// the displayed overlay stays alive even if evicted from the cache
+		CacheEntry    currentOverlay{};
+		std::uint32_t wantedOverlay{ INVALID_ID };
+
+		Map<std::uint32_t, CacheEntry> cache{};
+		std::size_t                    cacheBytes{ 0 };
+		std::size_t                    cacheBudget{ 512ull << 20 };
+		std::uint64_t                  useCounter{ 0 };
+		Set<std::uint32_t>             pending{};  // requested, not uploaded yet
+
+		std::mutex                  lock{};
+		std::condition_variable_any condition{};
+		std::deque<Request>         requests{};
+		std::deque<Result>          results{};
+		std::jthread                worker{};
 	};
 }
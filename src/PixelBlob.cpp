@@ -0,0 +1,135 @@
+#include "PixelBlob.h"
+
+namespace Texture
+{
+	std::string PixelBlob::Key::GetFileName() const
+	{
+		return std::format("{:016X}_{}x{}_{}.bin", source, width, height, std::to_underlying(format));
+	}
+
+	PixelBlob::~PixelBlob()
+	{
+		if (view) {
+			UnmapViewOfFile(view);
+		}
+		if (mapping) {
+			CloseHandle(mapping);
+		}
+		if (file != INVALID_HANDLE_VALUE) {
+			CloseHandle(file);
+		}
+	}
+
+	std::shared_ptr<PixelBlob> PixelBlob::Open(const std::filesystem::path& a_path, const Key& a_key)
+	{
+		auto blob = std::make_shared<PixelBlob>();
+
+		blob->file = CreateFileW(a_path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+		if (blob->file == INVALID_HANDLE_VALUE) {
+			return nullptr;
+		}
+
+		LARGE_INTEGER fileSize{};
+		if (!GetFileSizeEx(blob->file, &fileSize) || static_cast<std::uint64_t>(fileSize.QuadPart) < sizeof(Header)) {
+			return nullptr;
+		}
+
+		blob->mapping = CreateFileMappingW(blob->file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (!blob->mapping) {
+			return nullptr;
+		}
+
+		blob->view = MapViewOfFile(blob->mapping, FILE_MAP_READ, 0, 0, 0);
+		if (!blob->view) {
+			return nullptr;
+		}
+
+		Header header{};
+		std::memcpy(&header, blob->view, sizeof(Header));
+
+		// a stale key reads as a miss
+		if (header.magic != MAGIC || header.version != VERSION || header.source != a_key.source ||
+			header.keyWidth != a_key.width || header.keyHeight != a_key.height || header.format != static_cast<std::uint32_t>(a_key.format)) {
+			return nullptr;
+		}
+
+		// and so does a partial write
+		std::size_t rowPitch = 0;
+		std::size_t slicePitch = 0;
+		if (FAILED(DirectX::ComputePitch(a_key.format, header.width, header.height, rowPitch, slicePitch)) ||
+			header.rowPitch != rowPitch || header.dataSize != slicePitch ||
+			static_cast<std::uint64_t>(fileSize.QuadPart) != sizeof(Header) + slicePitch) {
+			return nullptr;
+		}
+
+		blob->image.width = header.width;
+		blob->image.height = header.height;
+		blob->image.format = a_key.format;
+		blob->image.rowPitch = rowPitch;
+		blob->image.slicePitch = slicePitch;
+		blob->image.pixels = const_cast<std::uint8_t*>(static_cast<const std::uint8_t*>(blob->view) + sizeof(Header));
+
+		return blob;
+	}
+
+	bool PixelBlob::Write(const std::filesystem::path& a_path, const Key& a_key, const DirectX::Image& a_image)
+	{
+		if (a_image.format != a_key.format || !a_image.pixels) {
+			return false;
+		}
+
+		std::size_t rowPitch = 0;
+		std::size_t slicePitch = 0;
+		if (FAILED(DirectX::ComputePitch(a_image.format, a_image.width, a_image.height, rowPitch, slicePitch))) {
+			return false;
+		}
+
+		const Header header{
+			MAGIC,
+			VERSION,
+			a_key.source,
+			a_key.width,
+			a_key.height,
+			static_cast<std::uint32_t>(a_key.format),
+			static_cast<std::uint32_t>(a_image.width),
+			static_cast<std::uint32_t>(a_image.height),
+			static_cast<std::uint32_t>(rowPitch),
+			slicePitch
+		};
+
+		std::error_code ec;
+		std::filesystem::create_directories(a_path.parent_path(), ec);
+
+		// readers only ever see complete blobs
+		auto tmpPath = a_path;
+		tmpPath += ".tmp";
+		{
+			std::ofstream file(tmpPath, std::ios::binary | std::ios::trunc);
+			if (!file) {
+				return false;
+			}
+
+			file.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+
+			// rows are packed, the source may be padded
+			const auto rowCount = slicePitch / rowPitch;
+			for (std::size_t row = 0; row < rowCount && file; ++row) {
+				file.write(reinterpret_cast<const char*>(a_image.pixels + (row * a_image.rowPitch)), static_cast<std::streamsize>(rowPitch));
+			}
+
+			if (!file) {
+				file.close();
+				std::filesystem::remove(tmpPath, ec);
+				return false;
+			}
+		}
+
+		std::filesystem::rename(tmpPath, a_path, ec);
+		if (ec) {
+			std::filesystem::remove(tmpPath, ec);
+			return false;
+		}
+
+		return true;
+	}
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+namespace Texture
+{
+	// Cached pixels stored as a fixed header followed by tightly packed rows.
+	// Blobs are mapped read-only, so pages come straight from the file cache and can be uploaded without a decode or copy.
+	// A blob is only valid for the exact key it was written with; mismatches and truncated files read as a miss.
+	// No game dependencies, only Win32 file mapping and DirectXTex image descriptions.
+	class PixelBlob
+	{
+	public:
+		struct Key
+		{
+			std::string GetFileName() const;  // {source}_{width}x{height}_{format}.bin
+
+			// members
+			std::uint64_t source;  // identity of the source file (path, size, mtime)
+			std::uint32_t width;   // resolution the source was resized for, the stored image may differ
+			std::uint32_t height;
+			DXGI_FORMAT   format;
+		};
+
+		PixelBlob() = default;
+		~PixelBlob();
+
+		PixelBlob(const PixelBlob&) = delete;
+		PixelBlob& operator=(const PixelBlob&) = delete;
+
+		static std::shared_ptr<PixelBlob> Open(const std::filesystem::path& a_path, const Key& a_key);  // nullptr on a miss
+		static bool                       Write(const std::filesystem::path& a_path, const Key& a_key, const DirectX::Image& a_image);
+
+		const DirectX::Image& GetImage() const { return image; }
+
+	private:
+		struct Header
+		{
+			std::uint32_t magic;
+			std::uint32_t version;
+			std::uint64_t source;
+			std::uint32_t keyWidth;
+			std::uint32_t keyHeight;
+			std::uint32_t format;
+			std::uint32_t width;
+			std::uint32_t height;
+			std::uint32_t rowPitch;
+			std::uint64_t dataSize;
+		};
+		static_assert(sizeof(Header) == 48);
+
+		static constexpr std::uint32_t MAGIC{ 0x42504D50 };  // PMPB
+		static constexpr std::uint32_t VERSION{ 1 };
+
+		// members
+		HANDLE         file{ INVALID_HANDLE_VALUE };
+		HANDLE         mapping{ nullptr };
+		const void*    view{ nullptr };
+		DirectX::Image image{};
+	};
+}
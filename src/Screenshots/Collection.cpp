@@ -0,0 +1,397 @@
+#include "Screenshots/Collection.h"
+
+#include "Graphics.h"
+
+namespace Screenshot
+{
+	Image::Image(std::string_view a_path, std::uint32_t a_index) :
+		path(std::format("{}/screenshot{}.dds", a_path, a_index)),
+		index(a_index)
+	{}
+
+	Image::Image(std::string& a_path) :
+		path(Texture::Sanitize(a_path)),
+		index(Path::ExtractIndex(path, "screenshot"sv))
+	{}
+
+	Image::Image(const Manifest::Entry& a_entry) :
+		path(a_entry.path),
+		index(a_entry.index)
+	{}
+
+	void Collection::LoadImages(std::string_view a_folder, Manifest& a_manifest)
+	{
+		if (const auto cached = a_manifest.GetValidFolder(a_folder)) {
+			images.reserve(cached->entries.size());
+			for (const auto& entry : cached->entries) {
+				images.emplace_back(entry);
+			}
+			std::sort(images.begin(), images.end());
+			return;
+		}
+
+		const std::filesystem::directory_entry folder{ a_folder };
+
+		std::error_code ec;
+		if (!folder.exists(ec)) {
+			logger::info("{} folder not found, creating it ({})", a_folder, ec.message());
+			std::filesystem::create_directory(a_folder);
+			a_manifest.SetFolder(a_folder, {});
+			return;
+		}
+
+		struct TextureFile
+		{
+			std::string          path;
+			Image                image;
+			std::uint64_t        size;
+			std::int64_t         mtime;
+			std::int64_t         lastShown{ 0 };
+			std::uint64_t        hash{ 0 };
+			DirectX::TexMetadata info{};
+			bool                 hasInfo{ false };
+		};
+
+		std::vector<TextureFile> files{};
+
+		for (const auto& entry : std::filesystem::directory_iterator(a_folder)) {
+			if (entry.is_regular_file()) {
+				if (const auto& path = entry.path(); path.extension() == ".dds") {
+					auto pathStr = entry.path().string();
+					auto imagePath = pathStr;
+					files.emplace_back(pathStr, Image(imagePath), static_cast<std::uint64_t>(entry.file_size(ec)), Manifest::GetLastWriteTime(path));
+				}
+			}
+		}
+
+		// reuse metadata for files that haven't changed since the manifest was last written
+		if (const auto previous = a_manifest.GetFolder(a_folder)) {
+			StringMap<const Manifest::Entry*> cache{};
+			cache.reserve(previous->entries.size());
+			for (const auto& entry : previous->entries) {
+				cache.emplace(entry.path, &entry);
+			}
+
+			for (auto& file : files) {
+				if (const auto it = cache.find(file.image.path); it != cache.end() && it->second->size == file.size && it->second->mtime == file.mtime) {
+					file.info.width = it->second->width;
+					file.info.height = it->second->height;
+					file.info.format = static_cast<DXGI_FORMAT>(it->second->format);
+					file.lastShown = it->second->lastShown;
+					file.hash = it->second->hash;
+					file.hasInfo = true;
+				}
+			}
+		}
+
+		// read remaining headers in parallel
+		std::vector<TextureFile*> uncachedFiles{};
+		for (auto& file : files) {
+			if (!file.hasInfo) {
+				uncachedFiles.push_back(&file);
+			}
+		}
+
+		if (!uncachedFiles.empty()) {
+			const std::size_t numThreads = std::min<std::size_t>(std::max(std::thread::hardware_concurrency(), 1u), uncachedFiles.size());
+
+			std::vector<std::jthread> threads;
+			threads.reserve(numThreads);
+
+			for (std::size_t i = 0; i < numThreads; ++i) {
+				threads.emplace_back([&, i]() {
+					for (std::size_t j = i; j < uncachedFiles.size(); j += numThreads) {
+						auto& file = *uncachedFiles[j];
+						file.hasInfo = SUCCEEDED(DirectX::GetMetadataFromDDSFile(stl::utf8_to_utf16(file.path)->c_str(), DirectX::DDS_FLAGS_NONE, file.info));
+					}
+				});
+			}
+
+			for (auto& thread : threads) {
+				thread.join();
+			}
+		}
+
+		std::vector<std::string>     badTextures{};
+		std::vector<Manifest::Entry> entries{};
+
+		images.reserve(files.size());
+		entries.reserve(files.size());
+
+		for (auto& file : files) {
+			if (!file.hasInfo) {
+				continue;
+			}
+
+			if (file.info.width % 4 != 0 || file.info.height % 4 != 0) {
+				badTextures.push_back(file.path);
+				continue;
+			}
+
+			entries.emplace_back(file.image.path, file.image.index,
+				static_cast<std::uint32_t>(file.info.width), static_cast<std::uint32_t>(file.info.height), static_cast<std::uint32_t>(file.info.format),
+				file.size, file.mtime, file.lastShown, file.hash);
+			images.push_back(std::move(file.image));
+		}
+
+		std::sort(images.begin(), images.end());
+
+		// delete off the loading thread
+		if (!badTextures.empty()) {
+			std::jthread([badTextures = std::move(badTextures)]() {
+				for (auto& badTexture : badTextures) {
+					logger::info("\tDeleting invalid texture ({})", badTexture);
+					std::error_code ec;
+					std::filesystem::remove(badTexture, ec);
+				}
+			}).detach();
+		}
+
+		a_manifest.SetFolder(a_folder, std::move(entries));
+	}
+
+	void Collection::SetSelection(std::size_t a_noRepeatCount, float a_newImageWeight)
+	{
+		noRepeatCount = a_noRepeatCount;
+		newImageWeight = std::clamp(a_newImageWeight, 0.1f, 10.0f);
+	}
+
+	void Collection::SyncBag()
+	{
+		// images loaded in bulk start with the default weight
+		for (auto idx = weights.size(); idx < images.size(); ++idx) {
+			weights.push_back(1.0f);
+			bag.push_back(idx);
+		}
+	}
+
+	void Collection::AddImage(Image& a_image)
+	{
+		SyncBag();
+
+		bag.push_back(images.size());
+		weights.push_back(newImageWeight);
+		maxWeight = std::max(maxWeight, newImageWeight);
+
+		images.emplace_back(a_image);
+	}
+
+	std::string Collection::GetKey(std::string a_path)
+	{
+		Path::NormalizeInPlace(a_path, "textures"sv);
+		return a_path;
+	}
+
+	void Collection::RemoveImages(const StringSet& a_paths)
+	{
+		SyncBag();
+
+		constexpr auto           removed = std::numeric_limits<std::size_t>::max();
+		std::vector<std::size_t> remap(images.size(), removed);
+
+		std::size_t kept = 0;
+		for (std::size_t idx = 0; idx < images.size(); ++idx) {
+			if (!a_paths.contains(GetKey(images[idx].path))) {
+				remap[idx] = kept;
+				if (kept != idx) {
+					images[kept] = std::move(images[idx]);
+					weights[kept] = weights[idx];
+				}
+				++kept;
+			}
+		}
+
+		if (kept == images.size()) {
+			return;
+		}
+
+		images.resize(kept);
+		weights.resize(kept);
+
+		const auto update = [&](auto& a_indices) {
+			std::erase_if(a_indices, [&](auto idx) { return remap[idx] == removed; });
+			for (auto& idx : a_indices) {
+				idx = remap[idx];
+			}
+		};
+		update(bag);
+		update(recent);
+
+		if (pending && remap[*pending] == removed) {
+			pending.reset();
+		} else if (pending) {
+			pending = remap[*pending];
+		}
+
+		maxWeight = weights.empty() ? 1.0f : *std::ranges::max_element(weights);
+	}
+
+	StringSet Collection::GetRecentPaths() const
+	{
+		StringSet paths;
+		for (const auto idx : recent) {
+			paths.emplace(GetKey(images[idx].path));
+		}
+		if (pending) {
+			paths.emplace(GetKey(images[*pending].path));
+		}
+		return paths;
+	}
+
+	void Collection::TrimRecent()
+	{
+		// keep at least one image in the bag
+		const auto window = std::min(noRepeatCount, images.size() - 1);
+		while (recent.size() > window) {
+			bag.push_back(recent.front());
+			recent.pop_front();
+		}
+	}
+
+	std::size_t Collection::PeekRandomIndex()
+	{
+		SyncBag();
+
+		if (images.size() <= 1) {
+			return 0;
+		}
+
+		if (pending) {
+			return *pending;
+		}
+
+		TrimRecent();
+
+		auto        rng = RNG();
+		std::size_t slot;
+		do {
+			slot = rng.generate<std::size_t>(0, bag.size() - 1);
+		} while (weights[bag[slot]] < maxWeight && rng.generate<float>(0.0f, maxWeight) >= weights[bag[slot]]);
+
+		pending = bag[slot];
+
+		return *pending;
+	}
+
+	const std::string& Collection::PeekRandomPath()
+	{
+		auto idx = PeekRandomIndex();
+		return images[idx].path;
+	}
+
+	void Collection::MarkShown(std::string_view a_key)
+	{
+		SyncBag();
+
+		// usually the pending pick, unless the load screen fell back to another draw
+		auto it = pending && GetKey(images[*pending].path) == a_key ?
+		              std::ranges::find(bag, *pending) :
+		              std::ranges::find_if(bag, [&](auto idx) { return GetKey(images[idx].path) == a_key; });
+		if (it == bag.end()) {
+			return;
+		}
+
+		const auto idx = *it;
+		*it = bag.back();
+		bag.pop_back();
+		recent.push_back(idx);
+
+		if (pending == idx) {
+			pending.reset();
+		}
+
+		TrimRecent();
+	}
+
+	std::int32_t Collection::GetHighestIndex() const
+	{
+		if (images.empty()) {
+			return -1;
+		}
+		return images.back().index + 1;
+	}
+
+	void HashIndex::Add(std::uint64_t a_hash, std::string a_path, std::int32_t a_index)
+	{
+		if (a_hash != 0) {
+			entries.emplace_back(a_hash, std::move(a_path), a_index);
+		}
+	}
+
+	void HashIndex::Remove(const StringSet& a_paths)
+	{
+		std::erase_if(entries, [&](const Entry& a_entry) { return a_paths.contains(a_entry.path); });
+	}
+
+	const std::string* HashIndex::FindNearest(std::uint64_t a_hash, std::uint32_t a_maxDistance, std::int32_t a_minIndex) const
+	{
+		const Entry*  nearest = nullptr;
+		std::uint32_t nearestDistance = a_maxDistance + 1;
+
+		for (const auto& entry : entries) {
+			if (entry.index < a_minIndex) {
+				continue;
+			}
+			if (const auto distance = Texture::HammingDistance(a_hash, entry.hash); distance < nearestDistance) {
+				nearest = &entry;
+				nearestDistance = distance;
+			}
+		}
+
+		return nearest ? &nearest->path : nullptr;
+	}
+
+	std::vector<Eviction> SelectEvictions(const Manifest& a_manifest, std::span<const std::string_view> a_folders, std::uint64_t a_budgetBytes, std::size_t a_maxCount, const StringSet& a_keep)
+	{
+		if (a_budgetBytes == 0 && a_maxCount == 0) {
+			return {};
+		}
+
+		struct Candidate
+		{
+			Eviction     eviction;
+			std::int64_t lastUsed;
+		};
+
+		std::vector<Candidate> candidates;
+		std::uint64_t          totalSize = 0;
+
+		for (const auto folder : a_folders) {
+			if (const auto cached = a_manifest.GetFolder(folder)) {
+				for (const auto& entry : cached->entries) {
+					candidates.emplace_back(Eviction{ folder, &entry }, std::max(entry.mtime, entry.lastShown));
+					totalSize += entry.size;
+				}
+			}
+		}
+
+		auto count = candidates.size();
+
+		const auto over_budget = [&]() {
+			return (a_budgetBytes > 0 && totalSize > a_budgetBytes) || (a_maxCount > 0 && count > a_maxCount);
+		};
+
+		std::vector<Eviction> evictions;
+		if (!over_budget()) {
+			return evictions;
+		}
+
+		std::ranges::stable_sort(candidates, std::less{}, &Candidate::lastUsed);
+
+		for (const auto& [eviction, lastUsed] : candidates) {
+			if (!over_budget()) {
+				break;
+			}
+			if (a_keep.contains(eviction.entry->path)) {
+				continue;
+			}
+
+			evictions.push_back(eviction);
+
+			totalSize -= eviction.entry->size;
+			--count;
+		}
+
+		return evictions;
+	}
+}
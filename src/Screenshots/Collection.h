@@ -0,0 +1,96 @@
+#pragma once
+
+#include "Screenshots/Manifest.h"
+
+namespace Screenshot
+{
+	// .../Screenshot48.dds, 48
+	struct Image
+	{
+		Image() = default;
+		Image(std::string_view a_path, std::uint32_t a_index);
+		Image(std::string& a_path);
+		Image(const Manifest::Entry& a_entry);
+
+		bool operator<(const Image& a_rhs) const
+		{
+			return index < a_rhs.index;
+		}
+
+		// members
+		std::string  path{};
+		std::int32_t index{ -1 };
+	};
+
+	// Collection of photo textures to be displayed on loading screens.
+	// Shuffle bag: draws come from images not shown in the last noRepeatCount picks, which return to the bag once they leave that window.
+	// A draw is only a peek, the same image is returned until it's marked shown, so picks made ahead of time don't use up the window.
+	// Draws and additions are O(1); weights are applied by rejection against the largest weight.
+	struct Collection
+	{
+		bool        empty() const { return images.empty(); }
+		std::size_t size() const { return images.size(); }
+
+		void               SetSelection(std::size_t a_noRepeatCount, float a_newImageWeight);
+		void               LoadImages(std::string_view a_folder, Manifest& a_manifest);
+		void               AddImage(Image& a_image);  // weighted by newImageWeight
+		void               RemoveImages(const StringSet& a_paths);
+		StringSet          GetRecentPaths() const;  // including the pending pick
+		const std::string& PeekRandomPath();
+		void               MarkShown(std::string_view a_key);
+		std::int32_t       GetHighestIndex() const;
+
+		static std::string GetKey(std::string a_path);  // sanitized path, as stored in the manifest
+
+		// members
+		std::vector<Image> images{};
+
+	private:
+
+		std::size_t PeekRandomIndex();
+		void        TrimRecent();
+		void        SyncBag();
+
+		// members
+		std::vector<std::size_t>   bag{};      // selectable image indices
+		std::deque<std::size_t>    recent{};   // shown image indices, oldest first
+		std::optional<std::size_t> pending{};  // drawn but not shown yet, still in the bag
+		std::vector<float>         weights{};  // parallel to images
+		float                      maxWeight{ 1.0f };
+		std::size_t                noRepeatCount{ 2 };
+		float                      newImageWeight{ 1.0f };
+	};
+
+	// Perceptual hashes of screenshot textures, matched by Hamming distance.
+	// A linear popcount scan, which stays in the microseconds for a few thousand textures.
+	class HashIndex
+	{
+	public:
+		void Add(std::uint64_t a_hash, std::string a_path, std::int32_t a_index);
+		void Remove(const StringSet& a_paths);
+
+		// only textures with an index of at least a_minIndex, nullptr if nothing is close enough
+		const std::string* FindNearest(std::uint64_t a_hash, std::uint32_t a_maxDistance, std::int32_t a_minIndex) const;
+
+	private:
+		struct Entry
+		{
+			std::uint64_t hash;
+			std::string   path;
+			std::int32_t  index;
+		};
+
+		// members
+		std::vector<Entry> entries{};
+	};
+
+	// DDS textures to evict so a folder set fits both limits (0 = unlimited), least recently shown/created first.
+	// Textures in a_keep are never picked, so the result may still be over budget.
+	struct Eviction
+	{
+		std::string_view       folder;
+		const Manifest::Entry* entry;
+	};
+
+	std::vector<Eviction> SelectEvictions(const Manifest& a_manifest, std::span<const std::string_view> a_folders, std::uint64_t a_budgetBytes, std::size_t a_maxCount, const StringSet& a_keep);
+}
@@ -5,6 +5,12 @@
 
 namespace LoadScreen
 {
+	void Manager::Register()
+	{
+		RE::UI::GetSingleton()->AddEventSink<RE::MenuOpenCloseEvent>(this);
+		logger::info("Registered for loading menu event");
+	}
+
 	void Manager::LoadMCMSettings(const CSimpleIniA& a_ini)
 	{
 		fullscreenChance = a_ini.GetLongValue("LoadScreen", "iChanceFullScreenArt", fullscreenChance);
@@ -63,44 +69,90 @@ namespace LoadScreen
 		return Type::kNone;
 	}
 
-	RE::TESObjectSTAT* Manager::LoadScreenshotModel()
+	Manager::Selection Manager::SelectScreenshotModel() const
 	{
-		current.type = GetScreenshotModelType();
+		Selection selection{};
+		selection.type = GetScreenshotModelType();
 
-		switch (current.type) {
+		switch (selection.type) {
 		case Type::kFullScreen:
-			{
-				current.obj = fullscreenModel;
-				current.texturePath = GetScreenshotTexture();
-
-				// skip if empty
-				if (current.texturePath.empty()) {
-					current.obj = nullptr;
-				}
-			}
+			selection.obj = fullscreenModel;
 			break;
 		case Type::kPainting:
-			{
-				current.obj = paintingModels[RNG().generate<std::size_t>(0, paintingModels.size() - 1)];  // Load random painting mesh
-				current.texturePath = GetScreenshotTexture();
-
-				// skip if empty
-				if (current.texturePath.empty()) {
-					current.obj = nullptr;
-				}
-			}
+			selection.obj = paintingModels[RNG().generate<std::size_t>(0, paintingModels.size() - 1)];  // Load random painting mesh
 			break;
 		default:
-			{
-				current.obj = nullptr;
-				current.texturePath.clear();
-			}
-			break;
+			return selection;
+		}
+
+		selection.texturePath = GetScreenshotTexture(selection.type);
+
+		// skip if empty
+		if (selection.texturePath.empty()) {
+			selection.obj = nullptr;
 		}
 
+		return selection;
+	}
+
+	RE::TESObjectSTAT* Manager::LoadScreenshotModel()
+	{
+		// the prefetched pick is stale if screenshots were disabled since
+		if (next && (next->type == Type::kNone || MANAGER(Screenshot)->CanDisplayScreenshotInLoadScreen())) {
+			current = std::move(*next);
+		} else {
+			current = SelectScreenshotModel();
+		}
+		next.reset();
+
 		return current.obj;
 	}
 
+	void Manager::PrefetchNextScreenshot()
+	{
+		// collections may still be loading, pick when the load screen starts instead
+		if (!MANAGER(Screenshot)->CanDisplayScreenshotInLoadScreen()) {
+			return;
+		}
+
+		next = SelectScreenshotModel();
+
+		if (!next->texturePath.empty()) {
+			std::jthread(WarmFileCache, next->texturePath).detach();
+		}
+	}
+
+	void Manager::WarmFileCache(std::string a_texturePath)
+	{
+		// background mode also lowers I/O priority, so this never competes with the game's own streaming
+		SetThreadPriority(GetCurrentThread(), THREAD_MODE_BACKGROUND_BEGIN);
+
+		Path::NormalizeInPlace(a_texturePath, "textures"sv);
+
+		std::ifstream file(std::format(R"(data\textures\{})", a_texturePath), std::ios::binary);
+		if (!file) {
+			logger::info("Couldn't prefetch {}", a_texturePath);
+			return;
+		}
+
+		std::vector<char> buffer(1 << 20);
+		while (file.read(buffer.data(), buffer.size()) || file.gcount() > 0) {}
+
+		SetThreadPriority(GetCurrentThread(), THREAD_MODE_BACKGROUND_END);
+	}
+
+	EventResult Manager::ProcessEvent(const RE::MenuOpenCloseEvent* a_evn, RE::BSTEventSource<RE::MenuOpenCloseEvent>*)
+	{
+		if (a_evn && a_evn->menuName == RE::LoadingMenu::MENU_NAME && !a_evn->opening) {
+			if (current.obj) {
+				MANAGER(Screenshot)->MarkShown(current.texturePath);
+			}
+			PrefetchNextScreenshot();
+		}
+
+		return EventResult::kContinue;
+	}
+
 	std::optional<Transform> Manager::GetModelTransform() const
 	{
 		switch (current.type) {
@@ -113,9 +165,9 @@ namespace LoadScreen
 		}
 	}
 
-	std::string Manager::GetScreenshotTexture() const
+	std::string Manager::GetScreenshotTexture(Type a_type) const
 	{
-		switch (current.type) {
+		switch (a_type) {
 		case Type::kFullScreen:
 			return MANAGER(Screenshot)->GetRandomScreenshot();
 		case Type::kPainting:
@@ -16,9 +16,12 @@ namespace LoadScreen
 		RE::NiPoint3 translateOffset{};
 	};
 
-	class Manager final : public REX::Singleton<Manager>
+	class Manager final :
+		public REX::Singleton<Manager>,
+		public RE::BSTEventSink<RE::MenuOpenCloseEvent>
 	{
 	public:
+		void Register();
 		void LoadMCMSettings(const CSimpleIniA& a_ini);
 		void InitLoadScreenObjects();
 
@@ -30,8 +33,22 @@ namespace LoadScreen
 		void ApplyScreenshotTexture(RE::BSGeometry* a_canvas) const;
 
 	private:
+		struct Selection
+		{
+			RE::TESObjectSTAT* obj{};
+			Type               type{ Type::kNone };
+			std::string        texturePath{};
+		};
+
 		Type        GetScreenshotModelType() const;
-		std::string GetScreenshotTexture() const;
+		std::string GetScreenshotTexture(Type a_type) const;
+		Selection   SelectScreenshotModel() const;
+
+		// picks the next load screen ahead of time and reads its texture into the OS file cache on a background thread
+		void        PrefetchNextScreenshot();
+		static void WarmFileCache(std::string a_texturePath);
+
+		EventResult ProcessEvent(const RE::MenuOpenCloseEvent* a_evn, RE::BSTEventSource<RE::MenuOpenCloseEvent>*) override;
 
 		// members
 		std::int32_t fullscreenChance{ 50 };
@@ -42,12 +59,7 @@ namespace LoadScreen
 		RE::TESObjectSTAT*              fullscreenModel{};
 		Transform                       fullscreenTransform{ 2.0f, RE::NiPoint3(), RE::NiPoint3(-45.0, 0, 0) };
 
-		struct
-		{
-			RE::TESObjectSTAT* obj{};
-			Type               type{ Type::kNone };
-			std::string        texturePath{};
-
-		} current;
+		Selection                current{};
+		std::optional<Selection> next{};
 	};
 }
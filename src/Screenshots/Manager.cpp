@@ -6,118 +6,81 @@
 
 namespace Screenshot
 {
-	Image::Image(std::string_view a_path, std::uint32_t a_index) :
-		path(std::format("{}/screenshot{}.dds", a_path, a_index)),
-		index(a_index)
-	{}
-
-	Image::Image(std::string& a_path) :
-		path(Texture::Sanitize(a_path))
+	void Manager::LoadMCMSettings(const CSimpleIniA& a_ini)
 	{
-		srell::smatch       matches;
-		static srell::regex screenshotPattern{ R"(screenshot(\d+))" };
-		if (srell::regex_search(path, matches, screenshotPattern)) {
-			if (matches.size() > 1) {
-				index = string::to_num<std::int32_t>(matches[1].str());
-			}
-		}
-	}
+		useCustomFolderDirectory = a_ini.GetBoolValue("Screenshots", "bCustomPhotoFolder", useCustomFolderDirectory);
+		autoHideMenus = a_ini.GetBoolValue("Screenshots", "bAutoHideMenus", autoHideMenus);
+		allowMultiScreenshots = a_ini.GetBoolValue("Screenshots", "bMultiScreenshots", allowMultiScreenshots);
+		takeScreenshotAsDDS = a_ini.GetBoolValue("Screenshots", "bLoadScreenPics", takeScreenshotAsDDS);
 
-	void Collection::LoadImages(std::string_view a_folder)
-	{
-		const std::filesystem::directory_entry folder{ a_folder };
+		applyPaintFilter = a_ini.GetBoolValue("Screenshots", "bPaintFilter", applyPaintFilter);
+		paintFilter.intensity = static_cast<float>(a_ini.GetDoubleValue("Screenshots", "fPaintIntensity", paintFilter.intensity));
+		paintFilter.radius = a_ini.GetLongValue("Screenshots", "iPaintRadius", paintFilter.radius);
 
-		std::error_code ec;
-		if (!folder.exists(ec)) {
-			logger::info("{} folder not found, creating it ({})", a_folder, ec.message());
-			std::filesystem::create_directory(a_folder);
-			return;
-		}
+		compressTextures = a_ini.GetBoolValue("Screenshots", "bCompressTextures", compressTextures);
+		forceSRGB = a_ini.GetBoolValue("Screenshots", "bForceSRGB", forceSRGB);
 
-		std::vector<std::string> badTextures{};
+		shareCopy.enabled = a_ini.GetBoolValue("Screenshots", "bShareCopy", shareCopy.enabled);
+		shareCopy.scale = static_cast<std::uint32_t>(std::max(a_ini.GetLongValue("Screenshots", "iShareCopyScale", shareCopy.scale), 1L));
+		shareCopy.format = static_cast<SHARE_FORMAT>(std::clamp(a_ini.GetLongValue("Screenshots", "iShareCopyFormat", std::to_underlying(shareCopy.format)), 0L, static_cast<long>(SHARE_FORMAT::kPNG)));
 
-		for (const auto& entry : std::filesystem::directory_iterator(a_folder)) {
-			if (entry.is_regular_file()) {
-				if (const auto& path = entry.path(); path.extension() == ".dds") {
-					auto pathStr = entry.path().string();
+		const auto noRepeatCount = static_cast<std::size_t>(std::max(a_ini.GetLongValue("Screenshots", "iNoRepeatCount", 2), 0L));
+		const auto newPhotoWeight = static_cast<float>(a_ini.GetDoubleValue("Screenshots", "fNewPhotoWeight", 1.0));
+		screenshots.SetSelection(noRepeatCount, newPhotoWeight);
+		paintings.SetSelection(noRepeatCount, newPhotoWeight);
 
-					DirectX::TexMetadata info;
-					GetMetadataFromDDSFile(stl::utf8_to_utf16(pathStr)->c_str(), DirectX::DDS_FLAGS_NONE, info);
+		dedup.enabled = a_ini.GetBoolValue("Screenshots", "bSkipDuplicateTextures", dedup.enabled);
+		dedup.maxDistance = static_cast<std::uint32_t>(std::clamp(a_ini.GetLongValue("Screenshots", "iDuplicateThreshold", dedup.maxDistance), 0L, 64L));
+		dedup.window = std::max(a_ini.GetLongValue("Screenshots", "iDuplicateWindow", dedup.window), 1L);
 
-					if (info.width % 4 != 0 || info.height % 4 != 0) {
-						badTextures.push_back(pathStr);
-						continue;
-					}
+		retention.budgetMB = static_cast<std::uint64_t>(std::max(a_ini.GetLongValue("Screenshots", "iTextureBudgetMB", 0), 0L));
+		retention.maxCount = static_cast<std::size_t>(std::max(a_ini.GetLongValue("Screenshots", "iTextureBudgetCount", 0), 0L));
 
-					images.push_back(pathStr);
-				}
+		reprocess.frameBudget = std::clamp(static_cast<float>(a_ini.GetDoubleValue("Screenshots", "fReprocessFrameBudget", reprocess.frameBudget)), 0.5f, 33.0f);
+		if (const auto toggle = a_ini.GetBoolValue("Screenshots", "bReprocessTextures", reprocess.mcmToggle); toggle != reprocess.mcmToggle) {
+			reprocess.mcmToggle = toggle;
+			if (StartReprocessing() == REPROCESS_RESULT::kStarted) {
+				RE::DebugNotification("$PM_ReprocessStarted"_T);
 			}
 		}
-
-		std::sort(images.begin(), images.end());
-
-		for (auto& badTexture : badTextures) {
-			logger::info("\tDeleting invalid texture ({})", badTexture);
-			std::filesystem::remove(badTexture);
-		}
 	}
 
-	void Collection::AddImage(Image& a_image)
+	void Manager::LoadScreenshots()
 	{
-		images.emplace_back(a_image);
+		loadTask = std::async(std::launch::async, [this]() {
+			const auto fileIndex = LoadScreenshotsImpl();
+			loaded = true;
+			return fileIndex;
+		});
 	}
 
-	std::size_t Collection::GetRandomIndex()
+	void Manager::OnLoadScreenshots()
 	{
-		auto maxIndex = images.size();
-
-		if (maxIndex <= 1) {
-			previousIndex[0] = 0;
-			previousIndex[1] = 0;
-			return 0;
+		if (!loaded || !loadTask.valid() || loadTask.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+			return;
 		}
 
-		std::size_t idx;
-		do {
-			idx = RNG().generate<std::size_t>(0, maxIndex - 1);
-		} while (idx == previousIndex[0] || idx == previousIndex[1]);
-
-		previousIndex[1] = previousIndex[0];
-		previousIndex[0] = idx;
-
-		return idx;
-	}
+		// the MCM ini and game settings aren't touched from the loading thread
+		const auto fileIndex = loadTask.get();
+		Settings::GetSingleton()->Save(FileType::kMCM, [&](auto& ini) {
+			index = ini.GetLongValue("Screenshots", "iScreenshotIndex", index);
+			AssignHighestPossibleIndex(fileIndex);
+			ini.SetLongValue("Screenshots", "iScreenshotIndex", index);
+		});
 
-	const std::string& Collection::GetRandomPath()
-	{
-		auto idx = GetRandomIndex();
-		return images[idx].path;
+		logger::info("\tscreenshot index : {}", index);
 	}
 
-	std::int32_t Collection::GetHighestIndex() const
+	void Manager::WaitForScreenshots()
 	{
-		if (images.empty()) {
-			return -1;
+		if (!loaded && loadTask.valid()) {
+			logger::info("Waiting for screenshots to finish loading...");
+			loadTask.wait();
 		}
-		return images.back().index + 1;
-	}
-
-	void Manager::LoadMCMSettings(const CSimpleIniA& a_ini)
-	{
-		useCustomFolderDirectory = a_ini.GetBoolValue("Screenshots", "bCustomPhotoFolder", useCustomFolderDirectory);
-		autoHideMenus = a_ini.GetBoolValue("Screenshots", "bAutoHideMenus", autoHideMenus);
-		allowMultiScreenshots = a_ini.GetBoolValue("Screenshots", "bMultiScreenshots", allowMultiScreenshots);
-		takeScreenshotAsDDS = a_ini.GetBoolValue("Screenshots", "bLoadScreenPics", takeScreenshotAsDDS);
-
-		applyPaintFilter = a_ini.GetBoolValue("Screenshots", "bPaintFilter", applyPaintFilter);
-		paintFilter.intensity = static_cast<float>(a_ini.GetDoubleValue("Screenshots", "fPaintIntensity", paintFilter.intensity));
-		paintFilter.radius = a_ini.GetLongValue("Screenshots", "iPaintRadius", paintFilter.radius);
-
-		compressTextures = a_ini.GetBoolValue("Screenshots", "bCompressTextures", compressTextures);
-		forceSRGB = a_ini.GetBoolValue("Screenshots", "bForceSRGB", forceSRGB);
+		OnLoadScreenshots();
 	}
 
-	void Manager::LoadScreenshots()
+	std::int32_t Manager::LoadScreenshotsImpl()
 	{
 		logger::info("Loading screenshots...");
 
@@ -137,18 +100,27 @@ namespace Screenshot
 		logger::info("\tScreenshot textures : {}", screenshotFolder);
 		logger::info("\tPainting textures : {}", paintingFolder);
 
-		screenshots.LoadImages(screenshotFolder);
-		paintings.LoadImages(paintingFolder);
+		manifest.Load();
 
-		Settings::GetSingleton()->Save(FileType::kMCM, [this](auto& ini) {
-			index = ini.GetLongValue("Screenshots", "iScreenshotIndex", index);
-			AssignHighestPossibleIndex();
-			ini.SetLongValue("Screenshots", "iScreenshotIndex", index);
-		});
+		screenshots.LoadImages(screenshotFolder, manifest);
+		paintings.LoadImages(paintingFolder, manifest);
+
+		ApplyRetentionPolicy();
+
+		if (const auto cached = manifest.GetFolder(screenshotFolder)) {
+			for (const auto& entry : cached->entries) {
+				textureHashes.Add(entry.hash, entry.path, entry.index);
+			}
+		}
+
+		const auto fileIndex = GetHighestFileIndex();
+
+		manifest.Save();
 
 		logger::info("\t{} screenshots", screenshots.size());
 		logger::info("\t{} paintings", paintings.size());
-		logger::info("\tscreenshot index : {}", index);
+
+		return fileIndex;
 	}
 
 	std::uint32_t Manager::GetIndex() const
@@ -156,18 +128,28 @@ namespace Screenshot
 		return index;
 	}
 
-	void Manager::AssignHighestPossibleIndex()
+	std::int32_t Manager::GetHighestFileIndex()
 	{
 		const auto get_photos_index = [this]() {
-			std::vector<Image> photos{};
+			const auto photoFolder = photoDirectory.string();
+
+			if (const auto cached = manifest.GetValidFolder(photoFolder)) {
+				return cached->entries.empty() ? -1 : cached->entries.back().index + 1;
+			}
+
+			std::vector<Image>           photos{};
+			std::vector<Manifest::Entry> entries{};
 			for (const auto& entry : std::filesystem::directory_iterator(photoDirectory)) {
 				if (entry.is_regular_file()) {
 					if (const auto& path = entry.path(); path.extension() == ".png") {
-						auto pathStr = entry.path().string();
-						photos.push_back(pathStr);
+						auto        pathStr = entry.path().string();
+						const auto& photo = photos.emplace_back(pathStr);
+						entries.emplace_back(photo.path, photo.index, 0, 0, DXGI_FORMAT_UNKNOWN, static_cast<std::uint64_t>(entry.file_size()), Manifest::GetLastWriteTime(path));
 					}
 				}
 			}
+			manifest.SetFolder(photoFolder, std::move(entries));
+
 			if (photos.empty()) {
 				return -1;
 			}
@@ -175,21 +157,29 @@ namespace Screenshot
 			return photos.back().index + 1;
 		};
 
-		auto mcmIndex = index;
 		auto photosIndex = get_photos_index();
-		auto vanillaScreenshotIndex = RE::GetINISetting("iScreenShotIndex:Display")->GetSInt();
 		auto screenshotsIndex = screenshots.GetHighestIndex();
 		auto paintingsIndex = paintings.GetHighestIndex();
 
-		logger::info("\tAssigning highest screenshot index...");
-		logger::info("\t\tmcm index: {}", mcmIndex);
-		logger::info("\t\tphoto directory index: {}", photosIndex);
-		logger::info("\t\tvanilla directory index: {}", vanillaScreenshotIndex);
-		logger::info("\t\tscreenshot textures index: {}", screenshotsIndex);
-		logger::info("\t\tpainting textures index: {}", paintingsIndex);
+		logger::info("\tphoto directory index: {}", photosIndex);
+		logger::info("\tscreenshot textures index: {}", screenshotsIndex);
+		logger::info("\tpainting textures index: {}", paintingsIndex);
+
+		return std::max({ photosIndex, screenshotsIndex, paintingsIndex });
+	}
+
+	void Manager::AssignHighestPossibleIndex(std::int32_t a_fileIndex)
+	{
+		auto mcmIndex = index;
+		auto vanillaScreenshotIndex = RE::GetINISetting("iScreenShotIndex:Display")->GetSInt();
+
+		logger::info("Assigning highest screenshot index...");
+		logger::info("\tmcm index: {}", mcmIndex);
+		logger::info("\tvanilla directory index: {}", vanillaScreenshotIndex);
+		logger::info("\tfile index: {}", a_fileIndex);
 
 		std::set<std::int32_t> indices;
-		indices.insert({ mcmIndex, photosIndex, vanillaScreenshotIndex, screenshotsIndex, paintingsIndex });
+		indices.insert({ mcmIndex, vanillaScreenshotIndex, a_fileIndex });
 
 		index = *indices.rbegin();
 	}
@@ -219,13 +209,54 @@ namespace Screenshot
 
 	bool Manager::CanDisplayScreenshotInLoadScreen() const
 	{
-		return takeScreenshotAsDDS && (!screenshots.empty() || !paintings.empty());
+		// vanilla load screens until the collections are ready
+		return loaded && takeScreenshotAsDDS && (!screenshots.empty() || !paintings.empty());
+	}
+
+	std::filesystem::path Manager::GetPhotoDirectory() const
+	{
+		return loaded ? photoDirectory : std::filesystem::path{};
+	}
+
+	void Manager::MarkShown(std::string_view a_texturePath)
+	{
+		if (!loaded || a_texturePath.empty()) {
+			return;
+		}
+
+		std::string path(a_texturePath);
+		Path::NormalizeInPlace(path, "textures"sv);
+
+		// the no-repeat window only counts load screens that were actually seen
+		screenshots.MarkShown(path);
+		paintings.MarkShown(path);
+
+		// saved with the next capture or game save, not every time a load screen closes
+		if (manifest.MarkShown(path)) {
+			manifestDirty = true;
+		}
+	}
+
+	void Manager::OnSaveGame()
+	{
+		if (manifestDirty) {
+			SaveManifest();
+		}
+	}
+
+	void Manager::SaveManifest()
+	{
+		manifest.Save();
+		manifestDirty = false;
 	}
 
 	bool Manager::TakeScreenshot()
 	{
 		bool skipVanillaScreenshot = false;
 
+		// index and photo directory are assigned by the loader
+		WaitForScreenshots();
+
 		const auto renderer = RE::BSGraphics::Renderer::GetSingleton();
 		if (!renderer) {
 			return skipVanillaScreenshot;
@@ -244,30 +275,50 @@ namespace Screenshot
 			std::string pngPath = useCustomFolderDirectory ? std::format("{}\\Screenshot{}.png", photoDirectory.string(), GetIndex()) :
 			                                                 std::format("{}_{}.png", RE::GetINISetting("sScreenShotBaseName:Display")->GetString(), GetIndex());
 
-			// apply overlay
-			if (const auto [overlay, alpha] = MANAGER(PhotoMode)->GetOverlay(); overlay) {
-				DirectX::ScratchImage overlayImage;
-				DirectX::ScratchImage blendedImage;
+			DirectX::ScratchImage blendedImage;
+			DirectX::ScratchImage shareImage;
 
-				// Convert PNG B8G8R8 format to R8G8B8
-				DirectX::Convert(overlay->image->GetImages(), 1,
-					overlay->image->GetMetadata(),
-					inputImage.GetMetadata().format, DirectX::TEX_FILTER_DEFAULT, DirectX::TEX_THRESHOLD_DEFAULT,
-					overlayImage);
+			const bool downscaleShareCopy = shareCopy.enabled && shareCopy.scale > 1;
 
-				Texture::AlphaBlendImage(inputImage.GetImages(), overlayImage.GetImages(), blendedImage, alpha);
+			std::uint64_t hash = 0;
+			const bool    hashCapture = dedup.enabled && takeScreenshotAsDDS;
 
-				TakeScreenshotAsTexture(blendedImage, inputImage);
-				Texture::SaveToPNG(blendedImage, pngPath, forceSRGB);
+			// overlays are stored in the capture format already, convert if the render target differs
+			DirectX::ScratchImage overlayImage;
+			const auto [overlay, alpha] = MANAGER(PhotoMode)->GetOverlay();
+			const DirectX::Image* overlayPixels = overlay.get();
+			if (overlayPixels && overlayPixels->format != inputImage.GetMetadata().format) {
+				DirectX::Convert(*overlayPixels, inputImage.GetMetadata().format, DirectX::TEX_FILTER_DEFAULT, DirectX::TEX_THRESHOLD_DEFAULT, overlayImage);
+				overlayPixels = overlayImage.GetImage(0, 0, 0);
+			}
+
+			// apply overlay, downscale the share copy and hash the photo from the same rows
+			Texture::ProcessCapture(inputImage.GetImages(), overlayPixels, alpha, blendedImage, downscaleShareCopy ? &shareImage : nullptr, shareCopy.scale, hashCapture ? &hash : nullptr);
+			overlayImage.Release();
+
+			const auto& photoImage = blendedImage.GetImageCount() > 0 ? blendedImage : inputImage;
+
+			TakeScreenshotAsTexture(photoImage, inputImage, hash);
+
+			if (useCustomFolderDirectory) {
+				manifest.BeginWrite(photoDirectory.string());
+			}
+			Texture::SaveToPNG(photoImage, pngPath, forceSRGB);
 
-				overlayImage.Release();
-				blendedImage.Release();
-			} else {
-				TakeScreenshotAsTexture(inputImage, inputImage);
-				Texture::SaveToPNG(inputImage, pngPath, forceSRGB);
+			if (shareCopy.enabled) {
+				SaveShareCopy(shareImage.GetImageCount() > 0 ? shareImage : photoImage, pngPath);
 			}
 
+			if (useCustomFolderDirectory) {
+				AddToManifest(photoDirectory.string(), pngPath, photoImage.GetMetadata());
+			}
+
+			blendedImage.Release();
+			shareImage.Release();
+
 			IncrementIndex();
+			ApplyRetentionPolicy();
+			SaveManifest();
 		}
 
 		inputImage.Release();
@@ -275,48 +326,130 @@ namespace Screenshot
 		return skipVanillaScreenshot;
 	}
 
-	void Manager::TakeScreenshotAsTexture(const DirectX::ScratchImage& a_ssImage, const DirectX::ScratchImage& a_paintingImage)
+	void Manager::SaveShareCopy(const DirectX::ScratchImage& a_image, const std::string& a_pngPath) const
+	{
+		const std::filesystem::path pngPath(a_pngPath);
+		const auto                  shareFolder = pngPath.parent_path() / "Share";
+
+		std::error_code ec;
+		if (!std::filesystem::exists(shareFolder, ec)) {
+			std::filesystem::create_directories(shareFolder, ec);
+		}
+
+		auto sharePath = (shareFolder / pngPath.stem()).string();
+		if (shareCopy.format == SHARE_FORMAT::kPNG) {
+			Texture::SaveToPNG(a_image, sharePath + ".png", forceSRGB);
+		} else {
+			Texture::SaveToJPG(a_image, sharePath + ".jpg", forceSRGB);
+		}
+	}
+
+	void Manager::AddToManifest(std::string_view a_folder, std::string a_path, const DirectX::TexMetadata& a_metadata, std::uint64_t a_hash)
+	{
+		std::error_code ec;
+		const auto      size = static_cast<std::uint64_t>(std::filesystem::file_size(a_path, ec));
+		const auto      mtime = Manifest::GetLastWriteTime(a_path);
+		const Image     image(a_path);  // same path/index as a folder scan
+
+		manifest.AddEntry(a_folder, { image.path, image.index, static_cast<std::uint32_t>(a_metadata.width), static_cast<std::uint32_t>(a_metadata.height), static_cast<std::uint32_t>(a_metadata.format), size, mtime, 0, a_hash });
+	}
+
+	void Manager::ApplyRetentionPolicy()
+	{
+		if (retention.budgetMB == 0 && retention.maxCount == 0) {
+			return;
+		}
+
+		// textures picked for the upcoming load screens stay
+		auto keep = screenshots.GetRecentPaths();
+		for (auto& path : paintings.GetRecentPaths()) {
+			keep.emplace(std::move(path));
+		}
+
+		// only the DDS folders, photos are never touched
+		const std::array folders{ screenshotFolder, paintingFolder };
+
+		const auto evictions = SelectEvictions(manifest, folders, retention.budgetMB * 1024 * 1024, retention.maxCount, keep);
+		if (evictions.empty()) {
+			return;
+		}
+
+		StringSet                evictedScreenshots;
+		StringSet                evictedPaintings;
+		std::vector<std::string> evictedFiles;
+
+		for (const auto& [folder, entry] : evictions) {
+			(folder == paintingFolder ? evictedPaintings : evictedScreenshots).emplace(entry->path);
+			manifest.AddSkipped(entry->index);
+			evictedFiles.push_back(std::format(R"(data\textures\{})", entry->path));
+		}
+
+		logger::info("	Evicting {} textures over budget", evictedFiles.size());
+
+		screenshots.RemoveImages(evictedScreenshots);
+		paintings.RemoveImages(evictedPaintings);
+		manifest.RemoveEntries(screenshotFolder, evictedScreenshots);
+		textureHashes.Remove(evictedScreenshots);
+		manifest.RemoveEntries(paintingFolder, evictedPaintings);
+
+		std::jthread([evictedFiles = std::move(evictedFiles)]() {
+			for (auto& file : evictedFiles) {
+				std::error_code ec;
+				std::filesystem::remove(file, ec);
+			}
+		}).detach();
+	}
+
+	void Manager::TakeScreenshotAsTexture(const DirectX::ScratchImage& a_ssImage, const DirectX::ScratchImage& a_paintingImage, std::uint64_t a_hash)
 	{
 		if (!takeScreenshotAsDDS || a_ssImage.GetMetadata().width % 4 != 0 || a_ssImage.GetMetadata().height % 4 != 0) {
 			return;
 		}
 
+		const auto hash = dedup.enabled ? a_hash : 0;
+		if (hash != 0) {
+			// a burst is a handful of consecutive captures, older photos of the same spot are kept on purpose
+			if (const auto original = textureHashes.FindNearest(hash, dedup.maxDistance, static_cast<std::int32_t>(GetIndex()) - dedup.window)) {
+				logger::info("Skipping load screen textures, capture is a near-duplicate of {}", *original);
+				manifest.AddSkipped(static_cast<std::int32_t>(GetIndex()));
+				return;
+			}
+		}
+
 		Image screenshotImage(screenshotFolder, GetIndex());
 		Image paintingImage(paintingFolder, GetIndex());
 
 		const auto renderer = RE::BSGraphics::Renderer::GetSingleton();
 
-		// regular
+		auto metadata = a_ssImage.GetMetadata();
 		if (compressTextures) {
-			DirectX::ScratchImage outputImage;
+			metadata.format = DXGI_FORMAT_BC7_UNORM;
+		}
 
-			Texture::CompressTexture(renderer, a_ssImage, outputImage);
-			Texture::SaveToDDS(outputImage, screenshotImage.path);
+		// regular
+		manifest.BeginWrite(screenshotFolder);
+		if (Texture::SaveToDDS(renderer, *a_ssImage.GetImage(0, 0, 0), screenshotImage.path, compressTextures)) {
+			AddToManifest(screenshotFolder, screenshotImage.path, metadata, hash);
 
-			outputImage.Release();
-		} else {
-			Texture::SaveToDDS(a_ssImage, screenshotImage.path);
+			std::string key = screenshotImage.path;
+			Path::NormalizeInPlace(key, "textures"sv);
+			textureHashes.Add(hash, std::move(key), screenshotImage.index);
+
+			screenshots.AddImage(screenshotImage);
 		}
 
 		// painting
 		if (applyPaintFilter) {
 			DirectX::ScratchImage outputImage;
 			Texture::OilPaintingFilter(a_paintingImage.GetImages(), paintFilter.radius, paintFilter.intensity, outputImage);
-
-			if (compressTextures) {
-				DirectX::ScratchImage compressedImage;
-				Texture::CompressTexture(renderer, outputImage, compressedImage);  // NOLINT(readability-suspicious-call-argument)
-				Texture::SaveToDDS(compressedImage, paintingImage.path);
-				compressedImage.Release();
-			} else {
-				Texture::SaveToDDS(outputImage, paintingImage.path);
+			manifest.BeginWrite(paintingFolder);
+			if (Texture::SaveToDDS(renderer, *outputImage.GetImage(0, 0, 0), paintingImage.path, compressTextures)) {
+				AddToManifest(paintingFolder, paintingImage.path, metadata);
+				paintings.AddImage(paintingImage);
 			}
 
 			outputImage.Release();
 		}
-
-		screenshots.AddImage(screenshotImage);
-		paintings.AddImage(paintingImage);
 	}
 
 	std::string Manager::GetRandomScreenshot()
@@ -325,7 +458,7 @@ namespace Screenshot
 			return {};
 		}
 
-		return screenshots.GetRandomPath();
+		return screenshots.PeekRandomPath();
 	}
 
 	std::string Manager::GetRandomPainting()
@@ -335,6 +468,102 @@ namespace Screenshot
 			return GetRandomScreenshot();
 		}
 
-		return paintings.GetRandomPath();
+		return paintings.PeekRandomPath();
+	}
+
+	Manager::REPROCESS_RESULT Manager::StartReprocessing()
+	{
+		if (!loaded) {
+			return REPROCESS_RESULT::kNotLoaded;
+		}
+		if (reprocess.reprocessor.IsRunning()) {
+			return REPROCESS_RESULT::kRunning;
+		}
+
+		// every photo, including those without textures yet, but evicted and duplicate ones stay gone
+		auto photos = Reprocessor::FindPhotos(photoDirectory, manifest.GetSkipped());
+
+		reprocess.knownTextures.clear();
+		for (const auto& image : screenshots.images) {
+			reprocess.knownTextures.emplace(Collection::GetKey(image.path));
+		}
+		for (const auto& image : paintings.images) {
+			reprocess.knownTextures.emplace(Collection::GetKey(image.path));
+		}
+
+		const Reprocessor::Options options{
+			.compress = compressTextures,
+			.paintFilter = applyPaintFilter,
+			.paintRadius = paintFilter.radius,
+			.paintIntensity = paintFilter.intensity,
+			.frameBudget = reprocess.frameBudget
+		};
+
+		if (!reprocess.reprocessor.Start(std::move(photos), options)) {
+			reprocess.knownTextures.clear();
+			return REPROCESS_RESULT::kNothingToDo;
+		}
+
+		logger::info("Reprocessing load screen textures from {}", photoDirectory.string());
+		return REPROCESS_RESULT::kStarted;
+	}
+
+	void Manager::CancelReprocessing()
+	{
+		if (!reprocess.reprocessor.IsRunning()) {
+			return;
+		}
+
+		reprocess.reprocessor.Cancel();
+		reprocess.knownTextures.clear();
+
+		// keep whatever finished so far
+		ApplyRetentionPolicy();
+		SaveManifest();
+
+		logger::info("Cancelled reprocessing load screen textures");
+	}
+
+	bool Manager::IsReprocessing() const
+	{
+		return reprocess.reprocessor.IsRunning();
+	}
+
+	void Manager::PrintReprocessingProgress() const
+	{
+		const auto [done, total] = reprocess.reprocessor.GetProgress();
+		RE::ConsoleLog::GetSingleton()->Print(std::format("Reprocessing load screen textures: {}/{} photos", done, total).c_str());
+	}
+
+	void Manager::UpdateReprocessing()
+	{
+		if (!reprocess.reprocessor.IsRunning()) {
+			return;
+		}
+
+		for (auto& output : reprocess.reprocessor.Update()) {
+			AddToManifest(output.folder, output.path, output.metadata, output.hash);
+
+			auto key = Collection::GetKey(output.path);
+			if (output.hash != 0) {
+				textureHashes.Remove(StringSet{ key });
+				textureHashes.Add(output.hash, key, output.index);
+			}
+			if (reprocess.knownTextures.emplace(std::move(key)).second) {
+				Image image(output.folder, output.index);
+				(output.folder == paintingFolder ? paintings : screenshots).AddImage(image);
+			}
+		}
+
+		if (!reprocess.reprocessor.IsRunning()) {
+			const auto [done, total] = reprocess.reprocessor.GetProgress();
+			logger::info("Reprocessed {}/{} photos", done, total);
+
+			reprocess.knownTextures.clear();
+			ApplyRetentionPolicy();  // paintings may have been added, or textures grown with different settings
+			SaveManifest();
+
+			RE::DebugNotification("$PM_ReprocessDone"_T);
+		}
 	}
 }
@@ -1,73 +1,79 @@
 #pragma once
 
+#include "Screenshots/Collection.h"
+#include "Screenshots/Manifest.h"
+#include "Screenshots/Reprocessor.h"
+
 namespace Screenshot
 {
 	inline std::string_view screenshotFolder{ R"(data\textures\photomode\screenshots)" };
 	inline std::string_view paintingFolder{ R"(data\textures\photomode\screenshots\paintings)" };
 
-	// .../Screenshot48.dds, 48
-	struct Image
-	{
-		Image() = default;
-		Image(std::string_view a_path, std::uint32_t a_index);
-		Image(std::string& a_path);
-
-		bool operator<(const Image& a_rhs) const
-		{
-			return index < a_rhs.index;
-		}
-
-		// members
-		std::string  path{};
-		std::int32_t index{ -1 };
-	};
-
-	// Collection of photo textures to be displayed on loading screens.
-	// Avoids consecutive screenshots in a row
-	struct Collection
-	{
-		bool        empty() const { return images.empty(); }
-		std::size_t size() const { return images.size(); }
-
-		void               LoadImages(std::string_view a_folder);
-		void               AddImage(Image& a_image);
-		const std::string& GetRandomPath();
-		std::int32_t       GetHighestIndex() const;
-
-		// members
-		std::vector<Image>         images{};
-		std::array<std::size_t, 2> previousIndex{ std::numeric_limits<std::size_t>::max() };
-
-	private:
-		std::size_t GetRandomIndex();
-	};
-
 	class Manager final : public REX::Singleton<Manager>
 	{
 	public:
 		void LoadMCMSettings(const CSimpleIniA& a_ini);
-		void LoadScreenshots();
+		void LoadScreenshots();  // async, nothing needs the collections until the first load screen or capture
+		void OnLoadScreenshots();  // main thread, once per frame; assigns the screenshot index after loading finishes
 
 		bool TakeScreenshot();
 
 		std::uint32_t GetIndex() const;
-		void          AssignHighestPossibleIndex();
+		void          AssignHighestPossibleIndex(std::int32_t a_fileIndex);
 		void          IncrementIndex();
 
-		bool        CanDisplayScreenshotInLoadScreen() const;
-		std::string GetRandomScreenshot();
-		std::string GetRandomPainting();
+		bool                  CanDisplayScreenshotInLoadScreen() const;
+		std::filesystem::path GetPhotoDirectory() const;  // empty until loaded
+		void                  MarkShown(std::string_view a_texturePath);
+		void                  OnSaveGame();  // writes load screen history batched since the last save
+		std::string           GetRandomScreenshot();
+		std::string           GetRandomPainting();
+
+		enum class REPROCESS_RESULT
+		{
+			kStarted,
+			kNotLoaded,
+			kRunning,
+			kNothingToDo  // no photos, or all of them skipped
+		};
+
+		// rebuilds load screen textures from the photo folder with the current texture settings
+		REPROCESS_RESULT StartReprocessing();
+		void CancelReprocessing();
+		bool IsReprocessing() const;
+		void UpdateReprocessing();  // render thread, once per frame
+		void PrintReprocessingProgress() const;
 
 		bool AllowMultiScreenshots() const;
 		bool CanAutoHideMenus() const;
 		bool CanApplyPaintFilter() const;
 
 	private:
-		void TakeScreenshotAsTexture(const DirectX::ScratchImage& a_ssImage, const DirectX::ScratchImage& a_paintingImage);
+		std::int32_t LoadScreenshotsImpl();  // returns the highest index found on disk
+		std::int32_t GetHighestFileIndex();
+		void         WaitForScreenshots();
+
+		enum class SHARE_FORMAT
+		{
+			kJPG,
+			kPNG
+		};
+
+		void TakeScreenshotAsTexture(const DirectX::ScratchImage& a_ssImage, const DirectX::ScratchImage& a_paintingImage, std::uint64_t a_hash);
+		void SaveShareCopy(const DirectX::ScratchImage& a_image, const std::string& a_pngPath) const;
+		void AddToManifest(std::string_view a_folder, std::string a_path, const DirectX::TexMetadata& a_metadata, std::uint64_t a_hash = 0);
+		void ApplyRetentionPolicy();
+		void SaveManifest();
 
 		// members
+		std::future<std::int32_t> loadTask{};
+		std::atomic_bool          loaded{ false };
+
+		Manifest     manifest{};
+		bool         manifestDirty{ false };  // shown stamps not saved yet
 		Collection   screenshots{};
 		Collection   paintings{};
+		HashIndex    textureHashes{};
 		std::int32_t index{ -1 };
 
 		bool takeScreenshotAsDDS{ true };
@@ -81,6 +87,38 @@ namespace Screenshot
 			float        intensity{ 30.0f };
 		} paintFilter;
 
+		// smaller copy for sharing, saved to Photos/Share
+		struct
+		{
+			bool          enabled{ false };
+			std::uint32_t scale{ 2 };
+			SHARE_FORMAT  format{ SHARE_FORMAT::kJPG };
+		} shareCopy;
+
+		// skip textures for captures that look like a recent one (burst shots in frozen time)
+		struct
+		{
+			bool          enabled{ false };
+			std::uint32_t maxDistance{ 3 };
+			std::int32_t  window{ 10 };  // previous captures compared against
+		} dedup;
+
+		// DDS textures are evicted least recently shown/created first once over budget, 0 = unlimited
+		struct
+		{
+			std::uint64_t budgetMB{ 0 };
+			std::size_t   maxCount{ 0 };
+		} retention;
+
+		// flipping the MCM toggle either way starts a pass, it has no state of its own
+		struct
+		{
+			Reprocessor reprocessor{};
+			StringSet   knownTextures{};  // textures already in the collections when the pass started
+			bool        mcmToggle{ false };
+			float       frameBudget{ 4.0f };
+		} reprocess;
+
 		bool allowMultiScreenshots{ true };
 		bool autoHideMenus{ true };
 
@@ -0,0 +1,160 @@
+#include "Screenshots/Manifest.h"
+
+namespace Screenshot
+{
+	std::int64_t Manifest::GetLastWriteTime(const std::filesystem::path& a_path)
+	{
+		std::error_code ec;
+		const auto      time = std::filesystem::last_write_time(a_path, ec);
+		return ec ? 0 : static_cast<std::int64_t>(time.time_since_epoch().count());
+	}
+
+	std::int64_t Manifest::GetTimestamp()
+	{
+		return static_cast<std::int64_t>(std::chrono::file_clock::now().time_since_epoch().count());
+	}
+
+	std::filesystem::path Manifest::GetPath()
+	{
+		static std::filesystem::path path{};
+		if (path.empty()) {
+			if (auto directory = logger::log_directory()) {
+				directory->remove_filename();
+				*directory /= "Saves\\PhotoMode\\Manifest.beve"sv;
+				path = *directory;
+			}
+		}
+		return path;
+	}
+
+	void Manifest::Load()
+	{
+		const auto path = GetPath();
+
+		std::error_code ec;
+		if (path.empty() || !std::filesystem::exists(path, ec)) {
+			return;
+		}
+
+		std::string buffer;
+		auto        glz_ec = glz::read_file_beve(*this, path.string(), buffer);
+		if (glz_ec || version != VERSION) {
+			logger::info("\tDiscarding screenshot manifest ({})", glz_ec ? glz::format_error(glz_ec, buffer) : "outdated version");
+			version = VERSION;
+			folders.clear();
+			skipped.clear();
+		}
+	}
+
+	void Manifest::Save() const
+	{
+		const auto path = GetPath();
+		if (path.empty()) {
+			return;
+		}
+
+		std::error_code ec;
+		if (!std::filesystem::exists(path.parent_path(), ec)) {
+			std::filesystem::create_directories(path.parent_path(), ec);
+		}
+
+		std::string buffer;
+		if (auto glz_ec = glz::write_file_beve(*this, path.string(), buffer)) {
+			logger::info("Failed to save screenshot manifest ({})", glz::format_error(glz_ec, buffer));
+		}
+	}
+
+	Manifest::Folder* Manifest::FindFolder(std::string_view a_folder)
+	{
+		const auto it = std::ranges::find(folders, a_folder, &Folder::path);
+		return it != folders.end() ? std::to_address(it) : nullptr;
+	}
+
+	const Manifest::Folder* Manifest::GetFolder(std::string_view a_folder) const
+	{
+		const auto it = std::ranges::find(folders, a_folder, &Folder::path);
+		return it != folders.end() ? std::to_address(it) : nullptr;
+	}
+
+	const Manifest::Folder* Manifest::GetValidFolder(std::string_view a_folder) const
+	{
+		const auto folder = GetFolder(a_folder);
+		if (!folder || folder->mtime == 0 || folder->mtime != GetLastWriteTime(a_folder)) {
+			return nullptr;
+		}
+		return folder;
+	}
+
+	void Manifest::SetFolder(std::string_view a_folder, std::vector<Entry> a_entries)
+	{
+		std::ranges::sort(a_entries, std::less{}, &Entry::index);
+
+		auto folder = FindFolder(a_folder);
+		if (!folder) {
+			folder = &folders.emplace_back(Folder{ std::string(a_folder) });
+		}
+
+		folder->mtime = GetLastWriteTime(a_folder);
+		folder->entries = std::move(a_entries);
+	}
+
+	void Manifest::BeginWrite(std::string_view a_folder)
+	{
+		if (auto folder = FindFolder(a_folder)) {
+			folder->unchanged = folder->mtime != 0 && folder->mtime == GetLastWriteTime(a_folder);
+		}
+	}
+
+	void Manifest::AddEntry(std::string_view a_folder, Entry a_entry)
+	{
+		// only extend folders that were already indexed, otherwise the next startup rescans them anyway
+		auto folder = FindFolder(a_folder);
+		if (!folder) {
+			return;
+		}
+
+		// entries stay sorted by index, whatever order they were written in
+		if (const auto it = std::ranges::find(folder->entries, a_entry.path, &Entry::path); it != folder->entries.end()) {
+			*it = std::move(a_entry);
+		} else {
+			const auto pos = std::ranges::upper_bound(folder->entries, a_entry.index, std::less{}, &Entry::index);
+			folder->entries.insert(pos, std::move(a_entry));
+		}
+
+		// restamp only if our write was the only change since the folder was last checked, anything else is picked up by the next rescan
+		if (std::exchange(folder->unchanged, false)) {
+			folder->mtime = GetLastWriteTime(a_folder);
+		}
+	}
+
+	void Manifest::RemoveEntries(std::string_view a_folder, const StringSet& a_paths)
+	{
+		// folder mtime is left alone, the files are deleted later and the next startup reuses cached headers when rescanning
+		if (auto folder = FindFolder(a_folder)) {
+			std::erase_if(folder->entries, [&](const Entry& a_entry) { return a_paths.contains(a_entry.path); });
+		}
+	}
+
+	bool Manifest::MarkShown(std::string_view a_path)
+	{
+		for (auto& folder : folders) {
+			if (const auto it = std::ranges::find(folder.entries, a_path, &Entry::path); it != folder.entries.end()) {
+				it->lastShown = GetTimestamp();
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void Manifest::AddSkipped(std::int32_t a_index)
+	{
+		if (const auto it = std::ranges::lower_bound(skipped, a_index); it == skipped.end() || *it != a_index) {
+			skipped.insert(it, a_index);
+		}
+	}
+
+	Set<std::int32_t> Manifest::GetSkipped() const
+	{
+		return { skipped.begin(), skipped.end() };
+	}
+}
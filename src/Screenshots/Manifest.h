@@ -0,0 +1,97 @@
+#pragma once
+
+namespace Screenshot
+{
+	// Binary record of screenshot textures and photos, so startup doesn't have to rescan each folder.
+	// A folder's entries are trusted as long as the folder's last write time matches the stored one.
+	class Manifest
+	{
+	public:
+		struct Entry
+		{
+			std::string   path{};
+			std::int32_t  index{ -1 };
+			std::uint32_t width{ 0 };
+			std::uint32_t height{ 0 };
+			std::uint32_t format{ DXGI_FORMAT_UNKNOWN };
+			std::uint64_t size{ 0 };
+			std::int64_t  mtime{ 0 };
+			std::int64_t  lastShown{ 0 };  // file clock, 0 if never shown on a load screen
+			std::uint64_t hash{ 0 };       // perceptual hash of the capture, 0 if unknown
+		};
+
+		struct Folder
+		{
+			std::string        path{};
+			std::int64_t       mtime{ 0 };
+			std::vector<Entry> entries{};
+			bool               unchanged{ false };  // not saved, the stamp still matched the folder right before our last write
+		};
+
+		static std::int64_t GetLastWriteTime(const std::filesystem::path& a_path);
+		static std::int64_t GetTimestamp();  // same clock as GetLastWriteTime
+
+		void Load();
+		void Save() const;
+
+		const Folder* GetFolder(std::string_view a_folder) const;  // may be stale
+		const Folder* GetValidFolder(std::string_view a_folder) const;
+		void          SetFolder(std::string_view a_folder, std::vector<Entry> a_entries);
+		void          BeginWrite(std::string_view a_folder);  // before writing a file that will be added, so the stamp can follow our own change
+		void          AddEntry(std::string_view a_folder, Entry a_entry);
+		void          RemoveEntries(std::string_view a_folder, const StringSet& a_paths);
+		bool          MarkShown(std::string_view a_path);
+
+		// photos whose load screen textures were evicted or skipped as duplicates, reprocessing leaves them alone
+		void              AddSkipped(std::int32_t a_index);
+		Set<std::int32_t> GetSkipped() const;
+
+		// members
+		std::uint32_t             version{ VERSION };
+		std::vector<Folder>       folders{};
+		std::vector<std::int32_t> skipped{};  // photo indices, sorted
+
+	private:
+		static constexpr std::uint32_t VERSION{ 5 };
+
+		static std::filesystem::path GetPath();
+		Folder*                      FindFolder(std::string_view a_folder);
+	};
+}
+
+// glaze
+template <>
+struct glz::meta<Screenshot::Manifest::Entry>
+{
+	using T = Screenshot::Manifest::Entry;
+	static constexpr auto value = object(
+		"path", &T::path,
+		"index", &T::index,
+		"width", &T::width,
+		"height", &T::height,
+		"format", &T::format,
+		"size", &T::size,
+		"mtime", &T::mtime,
+		"lastShown", &T::lastShown,
+		"hash", &T::hash);
+};
+
+template <>
+struct glz::meta<Screenshot::Manifest::Folder>
+{
+	using T = Screenshot::Manifest::Folder;
+	static constexpr auto value = object(
+		"path", &T::path,
+		"mtime", &T::mtime,
+		"entries", &T::entries);
+};
+
+template <>
+struct glz::meta<Screenshot::Manifest>
+{
+	using T = Screenshot::Manifest;
+	static constexpr auto value = object(
+		"version", &T::version,
+		"folders", &T::folders,
+		"skipped", &T::skipped);
+};
@@ -0,0 +1,262 @@
+#include "Screenshots/Reprocessor.h"
+
+#include "Screenshots/Manager.h"
+
+namespace Screenshot
+{
+	Reprocessor::~Reprocessor()
+	{
+		Cancel();
+	}
+
+	std::vector<Reprocessor::Photo> Reprocessor::FindPhotos(const std::filesystem::path& a_photoDirectory, const Set<std::int32_t>& a_skip)
+	{
+		std::vector<Photo> photos;
+
+		std::error_code ec;
+		for (const auto& entry : std::filesystem::directory_iterator(a_photoDirectory, ec)) {
+			if (!entry.is_regular_file(ec) || entry.path().extension() != ".png") {
+				continue;
+			}
+			auto stem = string::tolower(entry.path().stem().string());
+			if (const auto index = Path::ExtractIndex(stem, "screenshot"sv); index >= 0 && !a_skip.contains(index)) {
+				photos.emplace_back(index, entry.path());
+			}
+		}
+
+		std::ranges::sort(photos);
+		return photos;
+	}
+
+	void Reprocessor::RemoveStaleFiles(std::string_view a_folder)
+	{
+		std::error_code ec;
+		for (const auto& entry : std::filesystem::directory_iterator(a_folder, ec)) {
+			if (entry.is_regular_file(ec) && entry.path().extension() == ".tmp") {
+				logger::info("Removing stale {}", entry.path().string());
+				std::filesystem::remove(entry.path(), ec);
+			}
+		}
+	}
+
+	bool Reprocessor::Start(std::vector<Photo> a_photos, const Options& a_options)
+	{
+		if (running || a_photos.empty()) {
+			return false;
+		}
+
+		Reset();
+
+		options = a_options;
+		done = 0;
+		total = static_cast<std::uint32_t>(a_photos.size());
+		running = true;
+
+		worker = std::jthread([this, photos = std::move(a_photos)](std::stop_token a_token) mutable {
+			ProcessPhotos(std::move(a_token), std::move(photos));
+		});
+
+		return true;
+	}
+
+	void Reprocessor::Cancel()
+	{
+		if (worker.joinable()) {
+			// the worker reads options and fills this reprocessor's queue, so wait out the photo in progress
+			worker.request_stop();
+			worker.join();
+		}
+
+		Reset();
+	}
+
+	void Reprocessor::Reset()
+	{
+		{
+			std::scoped_lock guard(lock);
+			jobs.clear();
+		}
+
+		if (encoder) {
+			encoder->Finish();  // removes the partial file, the original texture is untouched
+			encoder.reset();
+		}
+
+		currentJob.reset();
+		encoderPath.clear();
+		encodingPainting = false;
+		decodingDone = false;
+		running = false;
+	}
+
+	void Reprocessor::ProcessPhotos(std::stop_token a_token, std::vector<Photo> a_photos)
+	{
+		// background mode also lowers I/O priority
+		SetThreadPriority(GetCurrentThread(), THREAD_MODE_BACKGROUND_BEGIN);
+
+		// nothing is encoding yet, so any temp file is from an earlier run that never finished
+		RemoveStaleFiles(screenshotFolder);
+		RemoveStaleFiles(paintingFolder);
+
+		// WIC decoding needs COM on this thread
+		const auto hr = CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+
+		for (const auto& [index, photo] : a_photos) {
+			{
+				std::unique_lock guard(lock);
+				if (!condition.wait(guard, a_token, [this] { return jobs.size() < MAX_QUEUED_JOBS; })) {
+					break;
+				}
+			}
+
+			Job        job{ index };
+			const bool prepared = PrepareJob(job, photo);
+
+			std::scoped_lock guard(lock);
+			if (a_token.stop_requested()) {
+				break;
+			}
+			if (prepared) {
+				jobs.push_back(std::move(job));
+			} else {
+				logger::info("Skipping {}, photo could not be decoded or isn't a multiple of 4", photo.string());
+				done++;
+			}
+		}
+
+		{
+			std::scoped_lock guard(lock);
+			if (!a_token.stop_requested()) {
+				decodingDone = true;
+			}
+		}
+
+		if (SUCCEEDED(hr)) {
+			CoUninitialize();
+		}
+	}
+
+	bool Reprocessor::PrepareJob(Job& a_job, const std::filesystem::path& a_photo) const
+	{
+		DirectX::ScratchImage photo;
+		if (FAILED(DirectX::LoadFromWICFile(a_photo.c_str(), DirectX::WIC_FLAGS_IGNORE_SRGB, nullptr, photo))) {
+			return false;
+		}
+
+		const auto& metadata = photo.GetMetadata();
+		if (metadata.width % 4 != 0 || metadata.height % 4 != 0) {
+			return false;
+		}
+
+		if (metadata.format != DXGI_FORMAT_R8G8B8A8_UNORM) {
+			if (FAILED(DirectX::Convert(*photo.GetImage(0, 0, 0), DXGI_FORMAT_R8G8B8A8_UNORM, DirectX::TEX_FILTER_DEFAULT, DirectX::TEX_THRESHOLD_DEFAULT, a_job.screenshot))) {
+				return false;
+			}
+		} else {
+			a_job.screenshot = std::move(photo);
+		}
+
+		a_job.hash = Texture::ComputeDHash(a_job.screenshot.GetImage(0, 0, 0));
+
+		if (options.paintFilter && !Texture::OilPaintingFilter(a_job.screenshot.GetImages(), options.paintRadius, options.paintIntensity, a_job.painting)) {
+			a_job.painting.Release();
+		}
+
+		return true;
+	}
+
+	bool Reprocessor::BeginNextTexture()
+	{
+		if (!currentJob) {
+			std::scoped_lock guard(lock);
+			if (jobs.empty()) {
+				return false;
+			}
+			currentJob.emplace(std::move(jobs.front()));
+			jobs.pop_front();
+			encodingPainting = false;
+			condition.notify_one();
+		}
+
+		const auto& image = encodingPainting ? currentJob->painting : currentJob->screenshot;
+
+		// encode next to the live texture and swap it in once complete, so a cancel never leaves a load screen without one
+		encoderPath = Image(encodingPainting ? paintingFolder : screenshotFolder, currentJob->index).path;
+		encoder.emplace(RE::BSGraphics::Renderer::GetSingleton(), *image.GetImage(0, 0, 0), encoderPath + ".tmp", options.compress);
+
+		return true;
+	}
+
+	bool Reprocessor::FinishTexture(std::vector<Output>& a_outputs)
+	{
+		const auto tmpPath = encoderPath + ".tmp";
+
+		bool saved = encoder->Finish();
+		encoder.reset();
+
+		if (saved) {
+			std::error_code ec;
+			std::filesystem::rename(tmpPath, encoderPath, ec);
+			if (ec) {
+				logger::info("Failed to replace {} ({})", encoderPath, ec.message());
+				std::filesystem::remove(tmpPath, ec);
+				saved = false;
+			}
+		}
+
+		if (saved) {
+			const auto& image = encodingPainting ? currentJob->painting : currentJob->screenshot;
+
+			auto metadata = image.GetMetadata();
+			if (options.compress) {
+				metadata.format = DXGI_FORMAT_BC7_UNORM;
+			}
+
+			a_outputs.emplace_back(encodingPainting ? paintingFolder : screenshotFolder, encoderPath, currentJob->index, metadata, encodingPainting ? 0 : currentJob->hash);
+		}
+
+		if (!encodingPainting && currentJob->painting.GetImageCount() > 0) {
+			encodingPainting = true;
+		} else {
+			currentJob.reset();
+			encodingPainting = false;
+			done++;
+		}
+
+		return saved;
+	}
+
+	std::vector<Reprocessor::Output> Reprocessor::Update()
+	{
+		std::vector<Output> outputs;
+		if (!running) {
+			return outputs;
+		}
+
+		const auto start = std::chrono::steady_clock::now();
+		const auto budget = std::chrono::duration<float, std::milli>(options.frameBudget);
+
+		// at least one tile per frame, however small the budget
+		do {
+			if (!encoder && !BeginNextTexture()) {
+				std::scoped_lock guard(lock);
+				if (decodingDone && jobs.empty()) {
+					running = false;
+				}
+				break;
+			}
+
+			if (encoder->IsValid()) {
+				encoder->Step();
+			}
+
+			if (!encoder->IsValid() || encoder->IsDone()) {
+				if (!FinishTexture(outputs)) {
+					logger::info("Failed to reprocess {}", encoderPath);
+				}
+			}
+		} while (std::chrono::steady_clock::now() - start < budget);
+
+		return outputs;
+	}
+}
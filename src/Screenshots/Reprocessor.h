@@ -0,0 +1,91 @@
+#pragma once
+
+#include "Graphics.h"
+
+namespace Screenshot
+{
+	// Regenerates screenshot and painting textures from photos already on disk.
+	// Photos are decoded and filtered on a low priority thread; GPU compression runs on the render thread, a few tiles per frame within a time budget.
+	class Reprocessor
+	{
+	public:
+		struct Options
+		{
+			bool         compress{ true };
+			bool         paintFilter{ true };
+			std::int32_t paintRadius{ 4 };
+			float        paintIntensity{ 30.0f };
+			float        frameBudget{ 4.0f };  // ms
+		};
+
+		struct Output
+		{
+			std::string_view     folder;
+			std::string          path;
+			std::int32_t         index;
+			DirectX::TexMetadata metadata;
+			std::uint64_t        hash;  // screenshots only
+		};
+
+		Reprocessor() = default;
+		~Reprocessor();
+
+		Reprocessor(const Reprocessor&) = delete;
+		Reprocessor& operator=(const Reprocessor&) = delete;
+
+		// Screenshot48.png, 48
+		using Photo = std::pair<std::int32_t, std::filesystem::path>;
+
+		// every photo in the folder but those in a_skip, sorted by index
+		static std::vector<Photo> FindPhotos(const std::filesystem::path& a_photoDirectory, const Set<std::int32_t>& a_skip);
+
+		// partial textures left behind when the game closed mid-encode
+		static void RemoveStaleFiles(std::string_view a_folder);
+
+		bool Start(std::vector<Photo> a_photos, const Options& a_options);  // false if running or there are no photos
+		void Cancel();
+
+		bool                                    IsRunning() const { return running; }
+		std::pair<std::uint32_t, std::uint32_t> GetProgress() const { return { done.load(), total.load() }; }
+
+		// render thread, once per frame; returns the textures finished this frame
+		std::vector<Output> Update();
+
+	private:
+		struct Job
+		{
+			std::int32_t          index;
+			DirectX::ScratchImage screenshot;
+			DirectX::ScratchImage painting;  // empty without the paint filter
+			std::uint64_t         hash;
+		};
+
+		// photos decoded ahead of the encoder, each holds a full resolution image or two
+		static constexpr std::size_t MAX_QUEUED_JOBS{ 2 };
+
+		void ProcessPhotos(std::stop_token a_token, std::vector<Photo> a_photos);
+		bool PrepareJob(Job& a_job, const std::filesystem::path& a_photo) const;
+		bool BeginNextTexture();
+		bool FinishTexture(std::vector<Output>& a_outputs);
+		void Reset();
+
+		// members
+		Options options{};
+
+		std::mutex                  lock{};
+		std::condition_variable_any condition{};
+		std::deque<Job>             jobs{};
+		std::jthread                worker{};
+
+		std::atomic_bool           running{ false };
+		std::atomic_bool           decodingDone{ false };
+		std::atomic<std::uint32_t> done{ 0 };
+		std::atomic<std::uint32_t> total{ 0 };
+
+		// render thread only
+		std::optional<Job>                 currentJob{};
+		std::optional<Texture::DDSEncoder> encoder{};
+		std::string                        encoderPath{};
+		bool                               encodingPainting{ false };
+	};
+}
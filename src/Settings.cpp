@@ -27,6 +27,17 @@ void Settings::LoadINI(const wchar_t* a_defaultPath, const wchar_t* a_userPath,
 	LoadINI(a_userPath, a_func);
 }
 
+std::uint64_t Settings::HashFile(const wchar_t* a_path)
+{
+	std::ifstream file(a_path, std::ios::binary);
+	if (!file) {
+		return 0;
+	}
+
+	const std::string contents{ std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+	return ankerl::unordered_dense::hash<std::string_view>{}(contents);
+}
+
 void Settings::Load(FileType type, INIFunc a_func, bool a_generate) const
 {
 	switch (type) {
@@ -80,3 +91,19 @@ void Settings::LoadMCMSettings() const
 
 	Load(FileType::kMCM, load_mcm);
 }
+
+std::uint64_t Settings::GetFingerprint(FileType type) const
+{
+	switch (type) {
+	case FileType::kFonts:
+		return HashFile(fontsPath);
+	case FileType::kStyles:
+		return HashFile(stylesPath);
+	case FileType::kMCM:
+		return HashFile(defaultMCMPath) ^ (HashFile(userMCMPath) * 31);
+	case FileType::kDisplayTweaks:
+		return HashFile(defaultDisplayTweaksPath) ^ (HashFile(userDisplayTweaksPath) * 31);
+	default:
+		return 0;
+	}
+}
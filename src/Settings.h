@@ -23,10 +23,15 @@ public:
 
 	void LoadMCMSettings() const;
 
+	// hash of the file contents, to tell whether settings changed since they were last applied
+	std::uint64_t GetFingerprint(FileType type) const;
+
 private:
 	static void LoadINI(const wchar_t* a_path, INIFunc a_func, bool a_generate = false);
 	static void LoadINI(const wchar_t* a_defaultPath, const wchar_t* a_userPath, INIFunc a_func);
 
+	static std::uint64_t HashFile(const wchar_t* a_path);
+
 	// members
 	const wchar_t* fontsPath{ L"Data/Interface/PhotoMode/fonts.ini" };
 	const wchar_t* stylesPath{ L"Data/Interface/PhotoMode/styles.ini" };
@@ -10,6 +10,8 @@ namespace Translation
 		void BuildTranslationMap();
 		bool LoadTranslation(const std::filesystem::path& a_path);
 
+		const StringMap<std::string>& GetTranslations() const { return translationMap; }
+
 		template <class T>
 		const std::string& GetTranslation(const T& a_key)
 		{
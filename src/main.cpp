@@ -54,12 +54,18 @@ void OnInit(SKSE::MessagingInterface::Message* a_msg)
 			MANAGER(Translation)->BuildTranslationMap();
 
 			MANAGER(LoadScreen)->InitLoadScreenObjects();
+			MANAGER(LoadScreen)->Register();
 			MANAGER(Screenshot)->LoadScreenshots();
 			MANAGER(PhotoMode)->OnDataLoad();
 
 			Console::Install();
 		}
 		break;
+	case SKSE::MessagingInterface::kSaveGame:
+		{
+			MANAGER(Screenshot)->OnSaveGame();
+		}
+		break;
 	default:
 		break;
 	}
@@ -0,0 +1,64 @@
+#include "AtlasPacker.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace
+{
+	bool Overlaps(const Texture::AtlasPacker::Rect& a_lhs, const Texture::AtlasPacker::Rect& a_rhs, std::uint32_t a_padding)
+	{
+		return a_lhs.page == a_rhs.page &&
+		       a_lhs.x < a_rhs.x + a_rhs.width + a_padding * 2 && a_rhs.x < a_lhs.x + a_lhs.width + a_padding * 2 &&
+		       a_lhs.y < a_rhs.y + a_rhs.height + a_padding * 2 && a_rhs.y < a_lhs.y + a_lhs.height + a_padding * 2;
+	}
+}
+
+TEST_CASE("AtlasPacker keeps padded rects apart and on their page", "[atlas]")
+{
+	constexpr std::uint32_t pageSize = 256;
+	constexpr std::uint32_t padding = 2;
+
+	std::vector<Texture::AtlasPacker::Size> sizes;
+	for (std::uint32_t i = 0; i < 200; ++i) {
+		sizes.push_back({ 8 + (i * 37) % 90, 8 + (i * 53) % 70 });
+	}
+
+	Texture::AtlasPacker packer(pageSize, pageSize, padding);
+	const auto           rects = packer.Pack(sizes);
+	REQUIRE(rects);
+	REQUIRE(rects->size() == sizes.size());
+	CHECK(packer.GetPageCount() > 1);
+
+	for (std::size_t i = 0; i < rects->size(); ++i) {
+		const auto& rect = (*rects)[i];
+
+		// input order
+		CHECK(rect.width == sizes[i].width);
+		CHECK(rect.height == sizes[i].height);
+
+		CHECK(rect.page < packer.GetPageCount());
+		CHECK(rect.x >= padding);
+		CHECK(rect.y >= padding);
+		CHECK(rect.x + rect.width + padding <= pageSize);
+		CHECK(rect.y + rect.height + padding <= packer.GetUsedHeight(rect.page));
+
+		for (std::size_t j = i + 1; j < rects->size(); ++j) {
+			CHECK_FALSE(Overlaps(rect, (*rects)[j], padding));
+		}
+	}
+}
+
+TEST_CASE("AtlasPacker handles empty and oversized rects", "[atlas]")
+{
+	Texture::AtlasPacker packer(64, 64, 1);
+
+	const std::array<Texture::AtlasPacker::Size, 2> empty{ { { 0, 10 }, { 10, 0 } } };
+	const auto                                      rects = packer.Pack(empty);
+	REQUIRE(rects);
+	CHECK((*rects)[0].width == 0);
+	CHECK((*rects)[1].height == 0);
+	CHECK(packer.GetPageCount() == 0);
+
+	// 63 plus padding on both sides
+	const std::array<Texture::AtlasPacker::Size, 1> oversized{ { { 63, 8 } } };
+	CHECK_FALSE(packer.Pack(oversized));
+}
@@ -0,0 +1,92 @@
+#include "Graphics.h"
+#include "ImGui/ScoreItems.h"
+#include "ImGui/TrigramIndex.h"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+namespace
+{
+	// roughly the shape and size of a modded load order's form list
+	std::vector<std::string> MakeFormNames(std::size_t a_count)
+	{
+		constexpr std::array prefixes{ "Iron", "Steel", "Orcish", "Dwarven", "Elven", "Glass", "Ebony", "Daedric", "Dragonbone", "Stalhrim" };
+		constexpr std::array nouns{ "Sword", "War Axe", "Mace", "Dagger", "Greatsword", "Battleaxe", "Warhammer", "Bow", "Helmet", "Gauntlets", "Boots", "Shield" };
+
+		std::vector<std::string> names;
+		names.reserve(a_count);
+		for (std::size_t i = 0; i < a_count; ++i) {
+			names.push_back(std::format("{} {} of the {} [{:08X}]", prefixes[i % prefixes.size()], nouns[(i / prefixes.size()) % nouns.size()], nouns[(i * 7) % nouns.size()], i));
+		}
+		return names;
+	}
+}
+
+TEST_CASE("Path normalizer", "[.benchmark]")
+{
+	std::vector<std::string> paths;
+	for (std::size_t i = 0; i < 1000; ++i) {
+		paths.push_back(std::format(R"(Data\\Textures/PhotoMode\Screenshots\Paintings\Screenshot{}.DDS)", i));
+	}
+
+	std::array<char, MAX_PATH> buffer{};
+
+	BENCHMARK("Normalize 1000 paths")
+	{
+		std::size_t length = 0;
+		for (const auto& path : paths) {
+			length += Path::Normalize(path, "textures"sv, buffer).size();
+		}
+		return length;
+	};
+
+	BENCHMARK("NormalizeInPlace 1000 paths")
+	{
+		std::size_t length = 0;
+		for (auto path : paths) {
+			Path::NormalizeInPlace(path, "textures"sv);
+			length += path.size();
+		}
+		return length;
+	};
+}
+
+TEST_CASE("Fuzzy scoring", "[.benchmark]")
+{
+	const auto names = MakeFormNames(50000);
+	const auto get_item = [&](int a_index) -> const std::string& { return names[a_index]; };
+
+	ImGui::TrigramIndex index;
+	index.Build(names);
+
+	BENCHMARK("ScoreItems, every item")
+	{
+		return ImGui::ScoreItems("Daedric Bow", get_item, names.size(), nullptr, 65.0, 64).ranked;
+	};
+
+	BENCHMARK("ScoreItems, trigram candidates")
+	{
+		const auto candidates = index.Query("Daedric Bow");
+		return ImGui::ScoreItems("Daedric Bow", get_item, names.size(), candidates ? &*candidates : nullptr, 65.0, 64).ranked;
+	};
+}
+
+TEST_CASE("Trigram index", "[.benchmark]")
+{
+	const auto names = MakeFormNames(50000);
+
+	ImGui::TrigramIndex index;
+	index.Build(names);
+
+	BENCHMARK("Build 50000 items")
+	{
+		ImGui::TrigramIndex built;
+		built.Build(names);
+		return built.IsBuilt();
+	};
+
+	BENCHMARK("Query")
+	{
+		return index.Query("dragonbone gauntlets")->size();
+	};
+}
@@ -0,0 +1,105 @@
+#include "Screenshots/Collection.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace
+{
+	constexpr std::string_view folder{ R"(data\textures\photomode\screenshots)" };
+
+	Screenshot::Collection MakeCollection(std::uint32_t a_count, std::size_t a_noRepeatCount)
+	{
+		Screenshot::Collection collection;
+		collection.SetSelection(a_noRepeatCount, 1.0f);
+		for (std::uint32_t i = 0; i < a_count; ++i) {
+			Screenshot::Image image(folder, i);
+			collection.AddImage(image);
+		}
+		return collection;
+	}
+
+	std::string ShowNext(Screenshot::Collection& a_collection)
+	{
+		auto key = Screenshot::Collection::GetKey(a_collection.PeekRandomPath());
+		a_collection.MarkShown(key);
+		return key;
+	}
+}
+
+TEST_CASE("Collection never repeats within the no-repeat window", "[collection]")
+{
+	constexpr std::size_t window = 3;
+	constexpr std::size_t draws = 2000;
+
+	auto collection = MakeCollection(10, window);
+
+	std::deque<std::string> recent;
+	StringMap<std::size_t>  counts;
+	for (std::size_t i = 0; i < draws; ++i) {
+		auto key = ShowNext(collection);
+		CHECK(std::ranges::find(recent, key) == recent.end());
+
+		counts[key]++;
+		recent.push_back(std::move(key));
+		if (recent.size() > window) {
+			recent.pop_front();
+		}
+	}
+
+	// every image keeps getting drawn, roughly evenly
+	REQUIRE(counts.size() == 10);
+	for (const auto& [key, count] : counts) {
+		CHECK(count > draws / 20);
+		CHECK(count < draws / 5);
+	}
+}
+
+TEST_CASE("Collection window is capped below the image count", "[collection]")
+{
+	// with three images and a window of five, only one image is ever selectable
+	auto collection = MakeCollection(3, 5);
+
+	std::vector<std::string> shown;
+	for (std::size_t i = 0; i < 9; ++i) {
+		shown.push_back(ShowNext(collection));
+	}
+
+	for (std::size_t i = 3; i < shown.size(); ++i) {
+		CHECK(shown[i] == shown[i - 3]);
+	}
+}
+
+TEST_CASE("Collection peeks don't use up the window", "[collection]")
+{
+	auto collection = MakeCollection(10, 3);
+
+	const auto pending = collection.PeekRandomPath();
+	for (std::size_t i = 0; i < 20; ++i) {
+		CHECK(collection.PeekRandomPath() == pending);
+	}
+
+	const auto key = Screenshot::Collection::GetKey(pending);
+	CHECK(collection.GetRecentPaths().contains(key));
+
+	// marking an image that isn't selectable changes nothing
+	collection.MarkShown("photomode\\missing.dds");
+	CHECK(collection.PeekRandomPath() == pending);
+
+	collection.MarkShown(key);
+	CHECK(collection.GetRecentPaths().contains(key));
+	CHECK(collection.PeekRandomPath() != pending);
+}
+
+TEST_CASE("Collection drops a removed pending pick", "[collection]")
+{
+	auto collection = MakeCollection(10, 3);
+
+	const auto key = Screenshot::Collection::GetKey(collection.PeekRandomPath());
+	collection.RemoveImages(StringSet{ key });
+
+	CHECK(collection.size() == 9);
+	CHECK_FALSE(collection.GetRecentPaths().contains(key));
+
+	for (std::size_t i = 0; i < 50; ++i) {
+		CHECK(ShowNext(collection) != key);
+	}
+}
@@ -0,0 +1,77 @@
+#include "ImGui/FontAtlasCache.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+TEST_CASE("FontAtlasCache restores a built atlas without rebuilding it", "[font]")
+{
+	ImFontAtlas atlas;
+	atlas.AddFontDefault();
+
+	ImFontConfig config;
+	config.SizePixels = 26.0f;
+	atlas.AddFontDefault(&config);
+
+	REQUIRE(atlas.Build());
+
+	ImGui::FontAtlasCache cache;
+	cache.key = 42;
+	REQUIRE(cache.Capture(&atlas));
+	CHECK(cache.fonts.size() == 2);
+
+	// through the on-disk format
+	std::string buffer;
+	REQUIRE_FALSE(glz::write_beve(cache, buffer));
+
+	ImGui::FontAtlasCache loaded;
+	REQUIRE_FALSE(glz::read_beve(loaded, buffer));
+	CHECK(loaded.version == ImGui::FontAtlasCache::VERSION);
+	CHECK(loaded.key == 42);
+
+	ImFontAtlas restored;
+	REQUIRE(loaded.Restore(&restored, ImGui::FontAtlasCache::GetPixels(&atlas)));
+
+	CHECK(restored.IsBuilt());
+	CHECK(restored.TexWidth == atlas.TexWidth);
+	CHECK(restored.TexHeight == atlas.TexHeight);
+	CHECK(restored.TexUvWhitePixel.x == atlas.TexUvWhitePixel.x);
+	CHECK(restored.TexUvWhitePixel.y == atlas.TexUvWhitePixel.y);
+	CHECK(std::memcmp(ImGui::FontAtlasCache::GetPixels(&restored), ImGui::FontAtlasCache::GetPixels(&atlas), static_cast<std::size_t>(atlas.TexWidth) * atlas.TexHeight * 4) == 0);
+
+	REQUIRE(restored.Fonts.Size == atlas.Fonts.Size);
+	for (int i = 0; i < atlas.Fonts.Size; ++i) {
+		const auto font = atlas.Fonts[i];
+		const auto restoredFont = restored.Fonts[i];
+
+		CHECK(restoredFont->FontSize == font->FontSize);
+		CHECK(restoredFont->Ascent == font->Ascent);
+		CHECK(restoredFont->Descent == font->Descent);
+		CHECK(restoredFont->Glyphs.Size == font->Glyphs.Size);
+
+		// lookup tables are rebuilt from the glyphs
+		for (const ImWchar codepoint : { L'A', L'g', L'~', L'?' }) {
+			const auto glyph = font->FindGlyph(codepoint);
+			const auto restoredGlyph = restoredFont->FindGlyph(codepoint);
+			REQUIRE(restoredGlyph);
+			CHECK(restoredGlyph->Codepoint == glyph->Codepoint);
+			CHECK(restoredGlyph->AdvanceX == glyph->AdvanceX);
+			CHECK(restoredGlyph->X0 == glyph->X0);
+			CHECK(restoredGlyph->Y1 == glyph->Y1);
+			CHECK(restoredGlyph->U0 == glyph->U0);
+			CHECK(restoredGlyph->V1 == glyph->V1);
+		}
+		CHECK(restoredFont->GetCharAdvance(L'W') == font->GetCharAdvance(L'W'));
+	}
+}
+
+TEST_CASE("FontAtlasCache refuses unbuilt atlases and empty tables", "[font]")
+{
+	ImFontAtlas atlas;
+	atlas.AddFontDefault();
+
+	ImGui::FontAtlasCache cache;
+	CHECK_FALSE(cache.Capture(&atlas));
+
+	const std::uint8_t pixel[4]{};
+	CHECK_FALSE(cache.Restore(&atlas, pixel));
+	CHECK_FALSE(cache.Restore(&atlas, nullptr));
+}
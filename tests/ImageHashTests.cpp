@@ -0,0 +1,133 @@
+#include "Graphics.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace
+{
+	// smooth waves running diagonally, so neighbouring hash cells differ clearly in both directions
+	DirectX::ScratchImage MakeImage(std::size_t a_width, std::size_t a_height, std::uint8_t a_alpha = 255, bool a_invert = false)
+	{
+		DirectX::ScratchImage image;
+		REQUIRE(SUCCEEDED(image.Initialize2D(DXGI_FORMAT_B8G8R8A8_UNORM, a_width, a_height, 1, 1)));
+
+		const auto& pixels = *image.GetImage(0, 0, 0);
+		for (std::size_t y = 0; y < a_height; ++y) {
+			auto row = pixels.pixels + y * pixels.rowPitch;
+			for (std::size_t x = 0; x < a_width; ++x, row += 4) {
+				const auto phase = 6.0 * x / a_width + 4.0 * y / a_height + 0.5;
+				const auto value = static_cast<std::uint8_t>(128.0 + 100.0 * std::sin(phase));
+				row[0] = row[1] = row[2] = a_invert ? static_cast<std::uint8_t>(255 - value) : value;
+				row[3] = a_alpha;
+			}
+		}
+
+		return image;
+	}
+
+	bool SamePixels(const DirectX::Image& a_lhs, const DirectX::Image& a_rhs)
+	{
+		if (a_lhs.width != a_rhs.width || a_lhs.height != a_rhs.height) {
+			return false;
+		}
+		for (std::size_t y = 0; y < a_lhs.height; ++y) {
+			if (std::memcmp(a_lhs.pixels + y * a_lhs.rowPitch, a_rhs.pixels + y * a_rhs.rowPitch, a_lhs.width * 4) != 0) {
+				return false;
+			}
+		}
+		return true;
+	}
+}
+
+TEST_CASE("HammingDistance counts differing bits", "[hash]")
+{
+	CHECK(Texture::HammingDistance(0, 0) == 0);
+	CHECK(Texture::HammingDistance(0, ~0ull) == 64);
+	CHECK(Texture::HammingDistance(0b1011, 0b0001) == 2);
+}
+
+TEST_CASE("ComputeDHash is stable and tolerates small changes", "[hash]")
+{
+	const auto image = MakeImage(160, 90);
+	const auto hash = Texture::ComputeDHash(image.GetImage(0, 0, 0));
+	REQUIRE(hash != 0);
+	CHECK(Texture::ComputeDHash(image.GetImage(0, 0, 0)) == hash);
+
+	auto noisy = MakeImage(160, 90);
+	const auto& pixels = *noisy.GetImage(0, 0, 0);
+	for (std::size_t i = 0; i < pixels.slicePitch; i += 97) {
+		pixels.pixels[i] ^= 1;
+	}
+	CHECK(Texture::HammingDistance(Texture::ComputeDHash(&pixels), hash) <= 3);
+
+	const auto inverted = MakeImage(160, 90, 255, true);
+	CHECK(Texture::HammingDistance(Texture::ComputeDHash(inverted.GetImage(0, 0, 0)), hash) > 32);
+}
+
+TEST_CASE("ComputeDHash rejects unsupported images", "[hash]")
+{
+	CHECK(Texture::ComputeDHash(nullptr) == 0);
+
+	const auto tiny = MakeImage(8, 8);
+	CHECK(Texture::ComputeDHash(tiny.GetImage(0, 0, 0)) == 0);
+
+	DirectX::ScratchImage wide;
+	REQUIRE(SUCCEEDED(wide.Initialize2D(DXGI_FORMAT_R16G16B16A16_UNORM, 64, 64, 1, 1)));
+	CHECK(Texture::ComputeDHash(wide.GetImage(0, 0, 0)) == 0);
+}
+
+TEST_CASE("ProcessCapture without an overlay only downscales and hashes", "[hash]")
+{
+	const auto base = MakeImage(160, 90);
+	const auto baseImage = base.GetImage(0, 0, 0);
+
+	DirectX::ScratchImage blended;
+	DirectX::ScratchImage downscaled;
+	std::uint64_t         hash = 0;
+	Texture::ProcessCapture(baseImage, nullptr, 1.0f, blended, &downscaled, 3, &hash);
+
+	CHECK(blended.GetImageCount() == 0);
+	CHECK(hash == Texture::ComputeDHash(baseImage));
+
+	REQUIRE(downscaled.GetImageCount() == 1);
+	const auto& small = *downscaled.GetImage(0, 0, 0);
+	CHECK(small.width == 53);
+	CHECK(small.height == 30);
+
+	// box average of the 3x3 block, rounded
+	for (const auto [x, y] : { std::pair{ 0, 0 }, std::pair{ 17, 11 }, std::pair{ 52, 29 } }) {
+		std::uint32_t sum = 0;
+		for (std::size_t dy = 0; dy < 3; ++dy) {
+			for (std::size_t dx = 0; dx < 3; ++dx) {
+				sum += baseImage->pixels[(y * 3 + dy) * baseImage->rowPitch + (x * 3 + dx) * 4];
+			}
+		}
+		CHECK(small.pixels[y * small.rowPitch + x * 4] == (sum + 4) / 9);
+	}
+}
+
+TEST_CASE("ProcessCapture blends, downscales and hashes the blended rows", "[hash]")
+{
+	const auto base = MakeImage(160, 90);
+	const auto overlay = MakeImage(160, 90, 255, true);
+
+	DirectX::ScratchImage blended;
+	DirectX::ScratchImage downscaled;
+	std::uint64_t         hash = 0;
+	Texture::ProcessCapture(base.GetImage(0, 0, 0), overlay.GetImage(0, 0, 0), 1.0f, blended, &downscaled, 2, &hash);
+
+	// an opaque overlay at full intensity replaces the colour
+	REQUIRE(blended.GetImageCount() == 1);
+	CHECK(SamePixels(*blended.GetImage(0, 0, 0), *overlay.GetImage(0, 0, 0)));
+	CHECK(hash == Texture::ComputeDHash(overlay.GetImage(0, 0, 0)));
+
+	DirectX::ScratchImage unused;
+	DirectX::ScratchImage expected;
+	Texture::ProcessCapture(overlay.GetImage(0, 0, 0), nullptr, 1.0f, unused, &expected, 2);
+	CHECK(SamePixels(*downscaled.GetImage(0, 0, 0), *expected.GetImage(0, 0, 0)));
+
+	// and a transparent one leaves the capture as is
+	const auto clear = MakeImage(160, 90, 0, true);
+	DirectX::ScratchImage untouched;
+	Texture::ProcessCapture(base.GetImage(0, 0, 0), clear.GetImage(0, 0, 0), 1.0f, untouched);
+	CHECK(SamePixels(*untouched.GetImage(0, 0, 0), *base.GetImage(0, 0, 0)));
+}
@@ -0,0 +1,45 @@
+#include "Graphics.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace
+{
+	std::string Normalize(std::string a_path, std::string_view a_root = "textures"sv)
+	{
+		Path::NormalizeInPlace(a_path, a_root);
+		return a_path;
+	}
+}
+
+TEST_CASE("Normalize lowercases and collapses separators", "[path]")
+{
+	CHECK(Normalize(R"(Data\Textures\PhotoMode\Screenshot1.dds)") == R"(photomode\screenshot1.dds)");
+	CHECK(Normalize("data//textures///photomode/Screenshot1.dds") == R"(photomode\screenshot1.dds)");
+	CHECK(Normalize(R"(\\textures\a.dds)") == "a.dds");
+}
+
+TEST_CASE("Normalize strips up to the first root folder only", "[path]")
+{
+	CHECK(Normalize(R"(textures\textures\a.dds)") == R"(textures\a.dds)");
+	CHECK(Normalize(R"(mytextures\a.dds)") == "a.dds");
+	CHECK(Normalize(R"(data\my textures\a.dds)") == R"(data\my textures\a.dds)");
+	CHECK(Normalize(R"(photomode\a.dds)") == R"(photomode\a.dds)");
+	CHECK(Normalize(R"(data\textures)") == R"(data\textures)");
+}
+
+TEST_CASE("Normalize writes into a separate buffer", "[path]")
+{
+	constexpr std::string_view path = R"(Data/Textures/A.DDS)";
+	std::array<char, path.size()> buffer{};
+
+	CHECK(Path::Normalize(path, "textures"sv, buffer) == "a.dds");
+	CHECK(Path::Normalize("", "textures"sv, buffer).empty());
+}
+
+TEST_CASE("ExtractIndex reads the number after the prefix", "[path]")
+{
+	CHECK(Path::ExtractIndex(R"(photomode\screenshot48.dds)", "screenshot"sv) == 48);
+	CHECK(Path::ExtractIndex(R"(screenshots\screenshot7.dds)", "screenshot"sv) == 7);
+	CHECK(Path::ExtractIndex(R"(screenshots\paintings.dds)", "screenshot"sv) == -1);
+	CHECK(Path::ExtractIndex("screenshot99999999999.dds", "screenshot"sv) == -1);
+}
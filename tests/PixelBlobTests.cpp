@@ -0,0 +1,74 @@
+#include "PixelBlob.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace
+{
+	std::filesystem::path GetTestDirectory()
+	{
+		auto directory = std::filesystem::temp_directory_path() / "PhotoModeTests" / "PixelBlob";
+		std::error_code ec;
+		std::filesystem::remove_all(directory, ec);
+		return directory;
+	}
+}
+
+TEST_CASE("PixelBlob round trips packed rows", "[blob]")
+{
+	DirectX::ScratchImage source;
+	REQUIRE(SUCCEEDED(source.Initialize2D(DXGI_FORMAT_R8G8B8A8_UNORM, 37, 21, 1, 1)));
+
+	const auto& image = *source.GetImage(0, 0, 0);
+	for (std::size_t i = 0; i < image.slicePitch; ++i) {
+		image.pixels[i] = static_cast<std::uint8_t>(i * 31);
+	}
+
+	const Texture::PixelBlob::Key key{ 0x1234'5678'9ABC'DEF0, 64, 32, DXGI_FORMAT_R8G8B8A8_UNORM };
+	CHECK(key.GetFileName() == "123456789ABCDEF0_64x32_28.bin");
+
+	const auto path = GetTestDirectory() / key.GetFileName();
+	REQUIRE(Texture::PixelBlob::Write(path, key, image));
+	CHECK_FALSE(std::filesystem::exists(path.string() + ".tmp"));
+
+	{
+		const auto blob = Texture::PixelBlob::Open(path, key);
+		REQUIRE(blob);
+
+		const auto& stored = blob->GetImage();
+		CHECK(stored.width == image.width);
+		CHECK(stored.height == image.height);
+		CHECK(stored.format == image.format);
+		CHECK(stored.slicePitch == image.slicePitch);
+		CHECK(std::memcmp(stored.pixels, image.pixels, image.slicePitch) == 0);
+	}
+
+	// any part of the key may go stale
+	auto otherSource = key;
+	otherSource.source++;
+	CHECK_FALSE(Texture::PixelBlob::Open(path, otherSource));
+
+	auto otherSize = key;
+	otherSize.width = 128;
+	CHECK_FALSE(Texture::PixelBlob::Open(path, otherSize));
+
+	auto otherFormat = key;
+	otherFormat.format = DXGI_FORMAT_B8G8R8A8_UNORM;
+	CHECK_FALSE(Texture::PixelBlob::Open(path, otherFormat));
+
+	// a partial write reads as a miss too
+	std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+	CHECK_FALSE(Texture::PixelBlob::Open(path, key));
+
+	CHECK_FALSE(Texture::PixelBlob::Open(path.parent_path() / "missing.bin", key));
+}
+
+TEST_CASE("PixelBlob only writes images matching the key", "[blob]")
+{
+	DirectX::ScratchImage source;
+	REQUIRE(SUCCEEDED(source.Initialize2D(DXGI_FORMAT_B8G8R8A8_UNORM, 4, 4, 1, 1)));
+
+	const Texture::PixelBlob::Key key{ 1, 4, 4, DXGI_FORMAT_R8G8B8A8_UNORM };
+	const auto                    path = GetTestDirectory() / key.GetFileName();
+	CHECK_FALSE(Texture::PixelBlob::Write(path, key, *source.GetImage(0, 0, 0)));
+	CHECK_FALSE(std::filesystem::exists(path));
+}
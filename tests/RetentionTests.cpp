@@ -0,0 +1,67 @@
+#include "Screenshots/Collection.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace
+{
+	constexpr std::string_view screenshots{ "screenshots" };
+	constexpr std::string_view paintings{ "paintings" };
+
+	Screenshot::Manifest::Entry MakeEntry(std::string_view a_folder, std::int32_t a_index, std::uint64_t a_size, std::int64_t a_mtime, std::int64_t a_lastShown = 0)
+	{
+		Screenshot::Manifest::Entry entry;
+		entry.path = std::format("{}\\screenshot{}.dds", a_folder, a_index);
+		entry.index = a_index;
+		entry.size = a_size;
+		entry.mtime = a_mtime;
+		entry.lastShown = a_lastShown;
+		return entry;
+	}
+
+	std::vector<std::string> Evict(const Screenshot::Manifest& a_manifest, std::uint64_t a_budgetBytes, std::size_t a_maxCount, const StringSet& a_keep = {})
+	{
+		constexpr std::array folders{ screenshots, paintings };
+
+		std::vector<std::string> paths;
+		for (const auto& [folder, entry] : Screenshot::SelectEvictions(a_manifest, folders, a_budgetBytes, a_maxCount, a_keep)) {
+			paths.push_back(entry->path);
+		}
+		return paths;
+	}
+}
+
+TEST_CASE("Retention evicts least recently used textures first", "[retention]")
+{
+	Screenshot::Manifest manifest;
+	manifest.SetFolder(screenshots, {
+		MakeEntry(screenshots, 0, 100, 10),
+		MakeEntry(screenshots, 1, 100, 20, 50),  // shown since, so newer than 2
+		MakeEntry(screenshots, 2, 100, 30),
+	});
+	manifest.SetFolder(paintings, {
+		MakeEntry(paintings, 0, 100, 15),
+	});
+
+	CHECK(Evict(manifest, 0, 0).empty());
+	CHECK(Evict(manifest, 400, 4).empty());
+
+	CHECK(Evict(manifest, 0, 2) == std::vector<std::string>{ R"(screenshots\screenshot0.dds)", R"(paintings\screenshot0.dds)" });
+	CHECK(Evict(manifest, 250, 0) == std::vector<std::string>{ R"(screenshots\screenshot0.dds)", R"(paintings\screenshot0.dds)" });
+	CHECK(Evict(manifest, 400, 1) == std::vector<std::string>{ R"(screenshots\screenshot0.dds)", R"(paintings\screenshot0.dds)", R"(screenshots\screenshot2.dds)" });
+}
+
+TEST_CASE("Retention never evicts kept textures", "[retention]")
+{
+	Screenshot::Manifest manifest;
+	manifest.SetFolder(screenshots, {
+		MakeEntry(screenshots, 0, 100, 10),
+		MakeEntry(screenshots, 1, 100, 20),
+	});
+
+	const StringSet keep{ R"(screenshots\screenshot0.dds)" };
+	CHECK(Evict(manifest, 0, 1, keep) == std::vector<std::string>{ R"(screenshots\screenshot1.dds)" });
+
+	// still over budget, but there is nothing left to take
+	const StringSet keepAll{ R"(screenshots\screenshot0.dds)", R"(screenshots\screenshot1.dds)" };
+	CHECK(Evict(manifest, 50, 0, keepAll).empty());
+}
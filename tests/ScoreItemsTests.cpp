@@ -0,0 +1,92 @@
+#include "ImGui/ScoreItems.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace
+{
+	constexpr double minScore = 65.0;
+
+	std::vector<std::string> MakeItems(std::size_t a_count)
+	{
+		constexpr std::array words{ "Iron", "Steel", "Sword", "Dagger", "Ebony", "Glass", "Bow", "Helmet", "Daedric", "Shield" };
+
+		std::vector<std::string> items;
+		items.reserve(a_count);
+		for (std::size_t i = 0; i < a_count; ++i) {
+			items.push_back(std::format("{} {} {:05}", words[i % words.size()], words[(i / words.size()) % words.size()], i));
+		}
+		return items;
+	}
+
+	// every item above the cutoff in list order, scored one by one
+	std::vector<int> ScoreAll(std::string_view a_pattern, const std::vector<std::string>& a_items)
+	{
+		rapidfuzz::fuzz::CachedPartialTokenRatio<char> scorer(a_pattern);
+
+		std::vector<int> matches;
+		for (int i = 0; i < static_cast<int>(a_items.size()); ++i) {
+			if (scorer.similarity(a_items[i], minScore) >= minScore) {
+				matches.push_back(i);
+			}
+		}
+		return matches;
+	}
+
+	void CheckRanked(const ImGui::ScoreResult& a_result)
+	{
+		const auto rankedEnd = a_result.scores.begin() + a_result.ranked;
+		CHECK(std::is_sorted(a_result.scores.begin(), rankedEnd, ImGui::RanksBefore));
+		if (a_result.ranked > 0) {
+			for (auto it = rankedEnd; it != a_result.scores.end(); ++it) {
+				CHECK_FALSE(ImGui::RanksBefore(*it, *(rankedEnd - 1)));
+			}
+		}
+	}
+}
+
+TEST_CASE("ScoreItems keeps every match and ranks only the requested prefix", "[score]")
+{
+	const auto items = MakeItems(500);
+	const auto get_item = [&](int a_index) -> const std::string& { return items[a_index]; };
+
+	auto result = ImGui::ScoreItems("Sword", get_item, items.size(), nullptr, minScore, 16);
+
+	CHECK(result.matches == ScoreAll("Sword", items));
+	REQUIRE(result.scores.size() == result.matches.size());
+	REQUIRE(result.scores.size() > 16);
+	CHECK(result.ranked == 16);
+	CheckRanked(result);
+
+	// scrolling further ranks more, already ranked rows stay put
+	const std::vector firstRanked(result.scores.begin(), result.scores.begin() + 16);
+	ImGui::RankScores(result.scores, result.ranked, result.scores.size() + 10);
+	CHECK(result.ranked == result.scores.size());
+	CHECK(std::equal(firstRanked.begin(), firstRanked.end(), result.scores.begin()));
+	CheckRanked(result);
+}
+
+TEST_CASE("ScoreItems only scores the candidates", "[score]")
+{
+	const auto items = MakeItems(500);
+	const auto get_item = [&](int a_index) -> const std::string& { return items[a_index]; };
+
+	const std::vector candidates{ 2, 3, 12, 40 };
+	const auto        result = ImGui::ScoreItems("Sword", get_item, items.size(), &candidates, minScore, 64);
+
+	for (const auto index : result.matches) {
+		CHECK(std::ranges::find(candidates, index) != candidates.end());
+	}
+	CHECK(result.matches == std::vector{ 2, 12 });
+}
+
+TEST_CASE("ScoreItems splits large lists across threads without changing the result", "[score]")
+{
+	const auto items = MakeItems(20000);
+	const auto get_item = [&](int a_index) -> const std::string& { return items[a_index]; };
+
+	const auto result = ImGui::ScoreItems("Daedric Bow", get_item, items.size(), nullptr, minScore, 64);
+
+	CHECK(result.matches == ScoreAll("Daedric Bow", items));
+	CHECK(result.ranked == std::min<std::size_t>(64, result.scores.size()));
+	CheckRanked(result);
+}
@@ -0,0 +1,46 @@
+#include "ImGui/TrigramIndex.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+TEST_CASE("TrigramIndex matches reordered words and typos", "[trigram]")
+{
+	const std::vector<std::string> items{ "Iron Sword", "Steel Sword", "Sword of Iron", "Iron Dagger", "Ale" };
+
+	ImGui::TrigramIndex index;
+	CHECK_FALSE(index.IsBuilt());
+	index.Build(items);
+	CHECK(index.IsBuilt());
+
+	CHECK(index.Query("iron sword") == std::vector{ 0, 1, 2, 3 });
+	CHECK(index.Query("SWORD") == std::vector{ 0, 1, 2 });
+	CHECK(index.Query("dagr") == std::vector{ 3 });
+	CHECK(index.Query("mace") == std::vector<int>{});
+	CHECK(index.Query("irn dagger") == std::vector{ 3 });
+}
+
+TEST_CASE("TrigramIndex has no opinion on patterns without trigrams", "[trigram]")
+{
+	const std::vector<std::string> items{ "Ale", "Mead" };
+
+	ImGui::TrigramIndex index;
+	index.Build(items);
+
+	CHECK_FALSE(index.Query("al"));
+	CHECK_FALSE(index.Query("a l e"));
+	CHECK(index.Query("ale") == std::vector{ 0 });
+}
+
+TEST_CASE("TrigramIndex returns positions within a subset", "[trigram]")
+{
+	const std::vector<std::string> items{ "Iron Sword", "Ale", "Steel Sword", "Mead" };
+
+	ImGui::TrigramIndex index;
+	index.Build(items);
+
+	const std::vector<std::uint32_t> subset{ 3, 2, 1 };
+	CHECK(index.Query("sword", &subset) == std::vector{ 1 });
+
+	index.Clear();
+	CHECK_FALSE(index.IsBuilt());
+	CHECK(index.Query("sword") == std::vector<int>{});
+}